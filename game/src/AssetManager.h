@@ -0,0 +1,515 @@
+#pragma once
+#include "raylib.h"
+#include "AudioMixer.h"
+#include "FileWatcher.h"
+#include "Level.h"
+#include "LockFreeQueue.h"
+#include "MeshCache.h"
+#include "TextureCache.h"
+#include "ThreadPool.h"
+#include "VirtualFileSystem.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// IO and decode threads, separate from DefaultThreadPool because importers ParallelFor on that pool
+// and would deadlock if every one of its workers were blocked inside a load
+#define ASSET_WORKER_COUNT 2
+
+// Completed loads waiting for the main thread, workers back off while it is full
+#define ASSET_QUEUE_CAPACITY 64
+
+// Seconds per frame spent uploading, at least one asset is uploaded every frame regardless
+#define ASSET_UPLOAD_BUDGET 0.004
+
+enum AssetType
+{
+    ASSET_TEXTURE,
+    ASSET_MODEL,
+    ASSET_SOUND,
+    ASSET_EFFECT,
+    ASSET_OBSTACLES
+};
+
+enum AssetState
+{
+    ASSET_LOADING,
+    ASSET_READY,
+    ASSET_FAILED
+};
+
+struct AssetHandle
+{
+    int id = -1;
+};
+
+typedef std::shared_ptr<const std::vector<Rectangle>> ObstacleSet;
+
+// CPU side of a load, filled on a worker and consumed by the main thread
+struct AssetPayload
+{
+    int id = -1;
+    bool loaded = false;
+    Image image{};
+    AssetFile cache;
+    std::vector<unsigned char> blob;
+    Wave wave{};                        // in the mixer format for effects
+    ObstacleSet obstacles;
+    ObstacleDiff obstacleDiff;
+};
+
+struct Asset
+{
+    AssetType type;
+    AssetState state = ASSET_LOADING;
+    std::string fileName;
+    std::string watchName;              // normalised, matched against file watcher paths
+    double requestTime = 0.0;
+    int version = 0;                    // bumped every time the asset is (re)loaded
+    bool inFlight = false;
+    bool reloadQueued = false;          // changed again while a load was in flight
+
+    TextureImportOptions textureOptions;
+    MeshImportOptions meshOptions;
+    AudioMixer* mixer = nullptr;        // effects are added to this mixer
+    int maxVoices = AUDIO_DEFAULT_VOICES_PER_SOUND;
+
+    Texture2D texture{};
+    LodModel model;
+    Sound sound{};
+    SoundEffect effect;
+    ObstacleSet obstacles;
+    std::deque<ObstacleDiff> obstacleChanges;
+};
+
+// Loads files on worker threads and hands the results back to the main thread through a lock-free queue,
+// where GPU uploads happen within a per-frame time budget. Handles resolve once their asset is ready.
+// With WatchForChanges, edited files are reloaded in the background and swapped in by Update.
+class AssetManager
+{
+public:
+    AssetManager() : mCompleted(ASSET_QUEUE_CAPACITY), mWorkers(ASSET_WORKER_COUNT)
+    {
+    }
+
+    // GPU resources must already be released by UnloadAll, this only waits for in-flight loads
+    ~AssetManager()
+    {
+        UnloadFileWatcher(mWatcher);
+        Drain();
+    }
+
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    AssetHandle RequestTexture(const char* fileName, const TextureImportOptions& options = TextureImportOptions())
+    {
+        AssetHandle handle = Add(ASSET_TEXTURE, fileName);
+        mAssets[handle.id].textureOptions = options;
+        Submit(handle.id);
+        return handle;
+    }
+
+    AssetHandle RequestModel(const char* fileName, const MeshImportOptions& options = MeshImportOptions())
+    {
+        AssetHandle handle = Add(ASSET_MODEL, fileName);
+        mAssets[handle.id].meshOptions = options;
+        Submit(handle.id);
+        return handle;
+    }
+
+    AssetHandle RequestSound(const char* fileName)
+    {
+        AssetHandle handle = Add(ASSET_SOUND, fileName);
+        Submit(handle.id);
+        return handle;
+    }
+
+    // Decoded and resampled on a worker, the main thread only hands the samples to mixer
+    AssetHandle RequestEffect(AudioMixer& mixer, const char* fileName, int maxVoices = AUDIO_DEFAULT_VOICES_PER_SOUND)
+    {
+        AssetHandle handle = Add(ASSET_EFFECT, fileName);
+        mAssets[handle.id].mixer = &mixer;
+        mAssets[handle.id].maxVoices = maxVoices;
+        Submit(handle.id);
+        return handle;
+    }
+
+    // The loaded set arrives through PollObstacleChanges as a diff against an empty level, later edits as
+    // diffs against the previous version of the file
+    AssetHandle RequestObstacles(const char* fileName)
+    {
+        AssetHandle handle = Add(ASSET_OBSTACLES, fileName);
+        Submit(handle.id);
+        return handle;
+    }
+
+    // Reloads assets whose files change under directory, returns false if it can't be watched
+    bool WatchForChanges(const char* directory)
+    {
+        UnloadFileWatcher(mWatcher);
+        mWatcher = LoadFileWatcher(directory, [this](const std::string& fileName)
+        {
+            std::lock_guard<std::mutex> lock(mChangedMutex);
+            mChanged.push_back(fileName);
+        });
+        return mWatcher != nullptr;
+    }
+
+    // Starts reloads for changed files and uploads completed loads until the budget runs out. Call once per
+    // frame on the main thread. Returns how many assets finished this call.
+    int Update(double budget = ASSET_UPLOAD_BUDGET)
+    {
+        ReloadChanged();
+
+        const double start = GetTime();
+        int finished = 0;
+        AssetPayload* payload;
+        while (mCompleted.TryPop(payload))
+        {
+            Finish(*payload);
+            delete payload;
+            mPending--;
+            finished++;
+
+            if (GetTime() - start >= budget) break;
+        }
+        return finished;
+    }
+
+    AssetState State(AssetHandle handle) const
+    {
+        return Valid(handle) ? mAssets[handle.id].state : ASSET_FAILED;
+    }
+
+    bool IsReady(AssetHandle handle) const
+    {
+        return State(handle) == ASSET_READY;
+    }
+
+    // Changes whenever the asset is replaced by a reload, so dependents know to rebind it
+    int Version(AssetHandle handle) const
+    {
+        return Valid(handle) ? mAssets[handle.id].version : 0;
+    }
+
+    // Loads requested but not yet uploaded
+    int Pending() const
+    {
+        return mPending;
+    }
+
+    // Each getter returns null until the asset is ready
+    Texture2D* GetTexture(AssetHandle handle)
+    {
+        return IsReady(handle) ? &mAssets[handle.id].texture : nullptr;
+    }
+
+    LodModel* GetModel(AssetHandle handle)
+    {
+        return IsReady(handle) ? &mAssets[handle.id].model : nullptr;
+    }
+
+    Sound* GetSound(AssetHandle handle)
+    {
+        return IsReady(handle) ? &mAssets[handle.id].sound : nullptr;
+    }
+
+    // An invalid effect until ready, which AudioMixer::Play ignores
+    SoundEffect GetEffect(AssetHandle handle)
+    {
+        return IsReady(handle) ? mAssets[handle.id].effect : SoundEffect();
+    }
+
+    const std::vector<Rectangle>* GetObstacles(AssetHandle handle)
+    {
+        return IsReady(handle) ? mAssets[handle.id].obstacles.get() : nullptr;
+    }
+
+    // Pops the oldest unapplied obstacle change, apply them in order to keep collision structures in sync
+    bool PollObstacleChanges(AssetHandle handle, ObstacleDiff& diff)
+    {
+        if (!Valid(handle) || mAssets[handle.id].obstacleChanges.empty()) return false;
+
+        std::deque<ObstacleDiff>& changes = mAssets[handle.id].obstacleChanges;
+        diff = std::move(changes.front());
+        changes.pop_front();
+        return true;
+    }
+
+    // Stops watching, waits for outstanding loads then releases every asset. Call before CloseWindow.
+    void UnloadAll()
+    {
+        UnloadFileWatcher(mWatcher);
+        mWatcher = nullptr;
+        Drain();
+        for (Asset& asset : mAssets)
+        {
+            if (asset.state == ASSET_READY) Release(asset);
+        }
+        mAssets.clear();
+    }
+
+private:
+    AssetHandle Add(AssetType type, const char* fileName)
+    {
+        Asset asset;
+        asset.type = type;
+        asset.fileName = fileName;
+        asset.watchName = NormalizePath(fileName);
+        mAssets.push_back(asset);
+
+        AssetHandle handle;
+        handle.id = (int)mAssets.size() - 1;
+        return handle;
+    }
+
+    bool Valid(AssetHandle handle) const
+    {
+        return handle.id >= 0 && handle.id < (int)mAssets.size();
+    }
+
+    // Queues the CPU half of a (re)load on the workers. Reloads after a change on disk re-import instead of
+    // trusting caches, two saves within a second leave the cache's mod time matching the new source.
+    void Submit(int id, bool reimport = false)
+    {
+        Asset& asset = mAssets[id];
+        asset.inFlight = true;
+        asset.requestTime = GetTime();
+        mPending++;
+
+        const std::string name = asset.fileName;
+        const TextureImportOptions textureOptions = asset.textureOptions;
+        const MeshImportOptions meshOptions = asset.meshOptions;
+        const ObstacleSet previous = asset.obstacles;
+        switch (asset.type)
+        {
+        case ASSET_TEXTURE:
+            mWorkers.Submit([this, id, name, textureOptions, reimport]
+            {
+                AssetPayload* payload = NewPayload(id);
+                payload->image = LoadImageCached(name.c_str(), textureOptions, reimport);
+                if (payload->image.data == nullptr) payload->image = LoadImage(name.c_str());
+                payload->loaded = payload->image.data != nullptr;
+                Complete(payload);
+            });
+            break;
+        case ASSET_MODEL:
+            mWorkers.Submit([this, id, name, meshOptions, reimport]
+            {
+                AssetPayload* payload = NewPayload(id);
+                payload->loaded = AcquireMeshCache(name.c_str(), meshOptions, payload->cache, payload->blob, reimport);
+                Complete(payload);
+            });
+            break;
+        case ASSET_SOUND:
+            mWorkers.Submit([this, id, name]
+            {
+                AssetPayload* payload = NewPayload(id);
+                payload->wave = LoadWave(name.c_str());
+                payload->loaded = payload->wave.data != nullptr;
+                Complete(payload);
+            });
+            break;
+        case ASSET_EFFECT:
+            mWorkers.Submit([this, id, name]
+            {
+                AssetPayload* payload = NewPayload(id);
+                payload->wave = LoadWave(name.c_str());
+                payload->loaded = payload->wave.data != nullptr && payload->wave.frameCount > 0;
+                if (payload->loaded) WaveFormat(&payload->wave, AUDIO_SAMPLE_RATE, 32, AUDIO_CHANNELS);
+                Complete(payload);
+            });
+            break;
+        case ASSET_OBSTACLES:
+            // The previous set is shared with the worker so the diff is computed off the main thread
+            mWorkers.Submit([this, id, name, previous]
+            {
+                AssetPayload* payload = NewPayload(id);
+                payload->loaded = AssetFileExists(name.c_str());
+                if (payload->loaded)
+                {
+                    std::shared_ptr<std::vector<Rectangle>> next(new std::vector<Rectangle>(LoadObstacles(name.c_str())));
+                    payload->obstacleDiff = DiffObstacles(previous ? *previous : std::vector<Rectangle>(), *next);
+                    payload->obstacles = next;
+                }
+                Complete(payload);
+            });
+            break;
+        }
+    }
+
+    static AssetPayload* NewPayload(int id)
+    {
+        AssetPayload* payload = new AssetPayload;
+        payload->id = id;
+        return payload;
+    }
+
+    // Worker side, the queue only fills when the main thread stalls so yielding is enough
+    void Complete(AssetPayload* payload)
+    {
+        while (!mCompleted.TryPush(payload))
+            std::this_thread::yield();
+    }
+
+    // Matches watcher paths against requested assets, a file changing mid-load is reloaded once that load lands
+    void ReloadChanged()
+    {
+        std::vector<std::string> changed;
+        {
+            std::lock_guard<std::mutex> lock(mChangedMutex);
+            changed.swap(mChanged);
+        }
+
+        for (const std::string& fileName : changed)
+        {
+            const std::string watchName = NormalizePath(fileName.c_str());
+            for (size_t id = 0; id < mAssets.size(); id++)
+            {
+                Asset& asset = mAssets[id];
+                if (asset.watchName != watchName) continue;
+
+                TraceLog(LOG_INFO, "ASSET: [%s] Changed on disk, reloading", asset.fileName.c_str());
+                if (asset.inFlight) asset.reloadQueued = true;
+                else Submit((int)id, true);
+            }
+        }
+    }
+
+    // Frees the GPU side of a ready asset
+    void Release(Asset& asset)
+    {
+        switch (asset.type)
+        {
+        case ASSET_TEXTURE:
+            UnloadTexture(asset.texture);
+            break;
+        case ASSET_MODEL:
+            UnloadLodModel(asset.model);
+            break;
+        case ASSET_SOUND:
+            UnloadSound(asset.sound);
+            break;
+        case ASSET_EFFECT:      // clips stay with the mixer, voices may still be playing them
+        case ASSET_OBSTACLES:
+            break;
+        }
+    }
+
+    // Main thread side, performs the GPU upload and releases the CPU copy. A failed reload keeps the old asset.
+    void Finish(AssetPayload& payload)
+    {
+        Asset& asset = mAssets[payload.id];
+        Asset loaded;
+        bool ready = payload.loaded;
+        switch (asset.type)
+        {
+        case ASSET_TEXTURE:
+            if (ready) loaded.texture = UploadImageCached(payload.image);
+            break;
+        case ASSET_MODEL:
+            if (ready)
+            {
+                loaded.model = UploadLodModel(payload.cache.data != nullptr ? payload.cache.data : payload.blob.data());
+                UnloadAssetFile(payload.cache);
+            }
+            else
+            {
+                // Not an OBJ the importer understands, let raylib try on this thread
+                loaded.model.lods.push_back(LoadModel(asset.fileName.c_str()));
+                loaded.model.errors.push_back(0.0f);
+                ready = loaded.model.lods[0].meshCount > 0;
+                if (!ready) UnloadLodModel(loaded.model);
+            }
+            break;
+        case ASSET_SOUND:
+            if (ready)
+            {
+                loaded.sound = LoadSoundFromWave(payload.wave);
+                UnloadWave(payload.wave);
+            }
+            break;
+        case ASSET_EFFECT:
+            if (ready)
+            {
+                loaded.effect = asset.mixer->LoadEffectFromWave(payload.wave, asset.maxVoices);
+                UnloadWave(payload.wave);
+                ready = loaded.effect.id >= 0;
+            }
+            break;
+        case ASSET_OBSTACLES:
+            break;
+        }
+
+        const bool reload = asset.state == ASSET_READY;
+        if (ready)
+        {
+            if (reload) Release(asset);
+            asset.texture = loaded.texture;
+            asset.model = std::move(loaded.model);
+            asset.sound = loaded.sound;
+            asset.effect = loaded.effect;
+            if (asset.type == ASSET_OBSTACLES)
+            {
+                asset.obstacles = payload.obstacles;
+                asset.obstacleChanges.push_back(std::move(payload.obstacleDiff));
+            }
+
+            asset.state = ASSET_READY;
+            asset.version++;
+            TraceLog(LOG_INFO, "ASSET: [%s] %s after %.2f ms", asset.fileName.c_str(), reload ? "Reloaded" : "Ready",
+                (GetTime() - asset.requestTime) * 1000.0);
+        }
+        else
+        {
+            if (!reload) asset.state = ASSET_FAILED;
+            TraceLog(LOG_WARNING, "ASSET: [%s] Failed to load", asset.fileName.c_str());
+        }
+
+        asset.inFlight = false;
+        if (asset.reloadQueued)
+        {
+            asset.reloadQueued = false;
+            Submit(payload.id, true);
+        }
+    }
+
+    // Discards loads still in flight without uploading them
+    void Drain()
+    {
+        while (mPending > 0)
+        {
+            AssetPayload* payload;
+            if (!mCompleted.TryPop(payload))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (payload->image.data != nullptr) UnloadImage(payload->image);
+            if (payload->wave.data != nullptr) UnloadWave(payload->wave);
+            UnloadAssetFile(payload->cache);
+            Asset& asset = mAssets[payload->id];
+            asset.inFlight = false;
+            if (asset.state == ASSET_LOADING) asset.state = ASSET_FAILED;
+            delete payload;
+            mPending--;
+        }
+    }
+
+    // Stable addresses so getters stay valid as more assets are requested
+    std::deque<Asset> mAssets;
+    int mPending = 0;
+
+    FileWatcher* mWatcher = nullptr;
+    std::mutex mChangedMutex;
+    std::vector<std::string> mChanged;
+
+    // Declared before the workers so it outlives them
+    LockFreeQueue<AssetPayload*> mCompleted;
+    ThreadPool mWorkers;
+};
@@ -0,0 +1,186 @@
+#pragma once
+#include "raylib.h"
+#include "Lz4.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Bump whenever the layout written by BuildPack changes
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_EXTENSION ".pak"
+
+// Entry data starts on this boundary so cache files mapped out of a pack keep their alignment
+#define ASSET_PACK_ALIGNMENT 16
+
+// Entries are only stored compressed when that saves at least 1/8 of their size
+#define ASSET_PACK_MIN_SAVING 8
+
+enum PackCompression
+{
+    PACK_STORED,
+    PACK_LZ4
+};
+
+// Pack file layout (little-endian):
+// PackHeader, PackEntry[entryCount] sorted by hash, NUL-terminated names, then entry data
+struct PackHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t namesSize;
+    uint64_t namesOffset;
+};
+
+struct PackEntry
+{
+    uint64_t hash;              // FNV-1a of the normalised path relative to the packed directory
+    uint64_t offset;
+    uint64_t size;              // bytes stored in the pack
+    uint64_t originalSize;
+    int64_t modTime;            // of the packed file, so caches stay valid against packed sources
+    uint32_t nameOffset;
+    uint32_t compression;
+};
+
+// Forward slashes, no "./" segments or repeated separators
+std::string NormalizePath(const char* path)
+{
+    std::string result;
+    for (const char* c = path; *c != '\0'; c++)
+    {
+        char ch = *c == '\\' ? '/' : *c;
+        if (ch == '/' && !result.empty() && result.back() == '/') continue;
+        if (ch == '.' && (result.empty() || result.back() == '/') && (c[1] == '/' || c[1] == '\\'))
+        {
+            c++;
+            continue;
+        }
+        result.push_back(ch);
+    }
+    while (result.size() > 1 && result.back() == '/')
+        result.pop_back();
+    return result;
+}
+
+uint64_t HashPath(const char* path, size_t length)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)path[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Bundles every file under directory into packFile, skipping the pack itself
+bool BuildPack(const char* directory, const char* packFile, bool compress = true)
+{
+    const std::string root = NormalizePath(directory) + "/";
+    const std::string packPath = NormalizePath(packFile);
+    const std::string tempName = packPath + ".tmp";
+    FilePathList files = LoadDirectoryFilesEx(directory, nullptr, true);
+
+    std::vector<std::string> names;
+    std::vector<std::string> paths;
+    for (unsigned int i = 0; i < files.count; i++)
+    {
+        std::string path = NormalizePath(files.paths[i]);
+        if (path == packPath || path == tempName || path.compare(0, root.size(), root) != 0) continue;
+        names.push_back(path.substr(root.size()));
+        paths.push_back(path);
+    }
+    UnloadDirectoryFiles(files);
+
+    std::vector<PackEntry> entries(names.size());
+    std::string nameTable;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        entries[i] = PackEntry{};
+        entries[i].hash = HashPath(names[i].c_str(), names[i].size());
+        entries[i].nameOffset = (uint32_t)nameTable.size();
+        nameTable.append(names[i].c_str(), names[i].size() + 1);
+    }
+
+    PackHeader header{};
+    memcpy(header.magic, "SPAK", 4);
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = (uint32_t)entries.size();
+    header.namesSize = (uint32_t)nameTable.size();
+    header.namesOffset = sizeof(PackHeader) + entries.size() * sizeof(PackEntry);
+
+    // Data is written first with the index left blank, then the finished index is written over it
+    std::ofstream out(tempName.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        TraceLog(LOG_WARNING, "PACK: [%s] Failed to open for writing", tempName.c_str());
+        return false;
+    }
+
+    uint64_t offset = header.namesOffset + header.namesSize;
+    std::vector<char> padding(ASSET_PACK_ALIGNMENT, 0);
+    std::vector<unsigned char> compressed;
+    size_t storedBytes = 0;
+    size_t originalBytes = 0;
+    out.seekp((std::streamoff)offset);
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        MappedFile file = LoadMappedFile(paths[i].c_str());
+        const unsigned char* data = file.data;
+        size_t size = file.size;
+
+        PackEntry& entry = entries[i];
+        entry.originalSize = size;
+        entry.modTime = GetFileModTime(paths[i].c_str());
+        entry.compression = PACK_STORED;
+        if (compress && size > 0)
+        {
+            compressed.resize(Lz4CompressBound(size));
+            size_t compressedSize = Lz4Compress(data, size, compressed.data());
+            if (compressedSize < size - size / ASSET_PACK_MIN_SAVING)
+            {
+                entry.compression = PACK_LZ4;
+                data = compressed.data();
+                size = compressedSize;
+            }
+        }
+
+        uint64_t aligned = (offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+        out.write(padding.data(), (std::streamsize)(aligned - offset));
+        entry.offset = aligned;
+        entry.size = size;
+        if (size > 0) out.write((const char*)data, (std::streamsize)size);
+        offset = aligned + size;
+
+        storedBytes += size;
+        originalBytes += entry.originalSize;
+        UnloadMappedFile(file);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const PackEntry& a, const PackEntry& b) { return a.hash < b.hash; });
+
+    out.seekp(0);
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)entries.data(), (std::streamsize)(entries.size() * sizeof(PackEntry)));
+    out.write(nameTable.data(), (std::streamsize)nameTable.size());
+    out.close();
+    if (!out)
+    {
+        TraceLog(LOG_WARNING, "PACK: [%s] Failed to write pack", tempName.c_str());
+        std::remove(tempName.c_str());
+        return false;
+    }
+
+    std::remove(packPath.c_str());
+    if (std::rename(tempName.c_str(), packPath.c_str()) != 0) return false;
+
+    TraceLog(LOG_INFO, "PACK: [%s] Packed %i files, %i -> %i bytes", packPath.c_str(), (int)entries.size(),
+        (int)originalBytes, (int)storedBytes);
+    return true;
+}
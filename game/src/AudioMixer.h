@@ -0,0 +1,262 @@
+#pragma once
+#include "raylib.h"
+#include "LockFreeQueue.h"
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define AUDIO_MIXER_SSE
+#endif
+
+// Every effect is resampled to this format when it is decoded, so mixing is a plain multiply-add
+#define AUDIO_SAMPLE_RATE 44100
+#define AUDIO_CHANNELS 2
+
+// Fixed voice pool, a new play steals the oldest voice once it is exhausted
+#define AUDIO_MAX_VOICES 32
+
+// Voices one effect may occupy before it steals from itself
+#define AUDIO_DEFAULT_VOICES_PER_SOUND 8
+
+// Plays requested between two audio callbacks, further requests are dropped
+#define AUDIO_COMMAND_CAPACITY 256
+
+enum AudioOutput
+{
+    AUDIO_OUTPUT_DEVICE,        // raylib audio stream, InitAudioDevice must already have been called
+    AUDIO_OUTPUT_NULL           // nothing is opened, the owner pulls samples with Mix
+};
+
+struct SoundEffect
+{
+    int id = -1;
+};
+
+// Effect decoded once to interleaved float PCM at the mixer format
+struct SoundClip
+{
+    std::vector<float> samples;
+    uint32_t frameCount = 0;
+    int maxVoices = AUDIO_DEFAULT_VOICES_PER_SOUND;
+};
+
+struct Voice
+{
+    const SoundClip* clip = nullptr;
+    uint32_t position = 0;
+    uint64_t started = 0;
+    float gainLeft = 0.0f;
+    float gainRight = 0.0f;
+};
+
+struct PlayCommand
+{
+    const SoundClip* clip;
+    float gainLeft;
+    float gainRight;
+};
+
+// Adds gain-scaled stereo frames into out
+void MixVoice(float* out, const float* in, uint32_t frames, float gainLeft, float gainRight)
+{
+    uint32_t count = frames * AUDIO_CHANNELS;
+    uint32_t i = 0;
+#ifdef AUDIO_MIXER_SSE
+    const __m128 gains = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), gains)));
+#endif
+    for (; i < count; i += 2)
+    {
+        out[i] += in[i] * gainLeft;
+        out[i + 1] += in[i + 1] * gainRight;
+    }
+}
+
+// Hard-clips the mix to [-1, 1]
+void ClampSamples(float* samples, uint32_t count)
+{
+    uint32_t i = 0;
+#ifdef AUDIO_MIXER_SSE
+    const __m128 lo = _mm_set1_ps(-1.0f);
+    const __m128 hi = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(samples + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i), lo), hi));
+#endif
+    for (; i < count; i++)
+        samples[i] = samples[i] < -1.0f ? -1.0f : (samples[i] > 1.0f ? 1.0f : samples[i]);
+}
+
+// Plays pre-decoded effects through a fixed voice pool. Play only queues a command, voices are owned by
+// whichever thread runs Mix (the raylib audio thread, or the caller with AUDIO_OUTPUT_NULL).
+class AudioMixer
+{
+public:
+    explicit AudioMixer(AudioOutput output = AUDIO_OUTPUT_DEVICE) : mCommands(AUDIO_COMMAND_CAPACITY), mOutput(output)
+    {
+        if (mOutput != AUDIO_OUTPUT_DEVICE) return;
+
+        // raylib's stream callback carries no user pointer, so only one device mixer can be live
+        ActiveMixer() = this;
+        mStream = LoadAudioStream(AUDIO_SAMPLE_RATE, 32, AUDIO_CHANNELS);
+        SetAudioStreamCallback(mStream, StreamCallback);
+        PlayAudioStream(mStream);
+    }
+
+    ~AudioMixer()
+    {
+        Close();
+    }
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    // Stops the output stream, call before CloseAudioDevice
+    void Close()
+    {
+        if (mOutput != AUDIO_OUTPUT_DEVICE) return;
+
+        StopAudioStream(mStream);
+        UnloadAudioStream(mStream);
+        ActiveMixer() = nullptr;
+        mOutput = AUDIO_OUTPUT_NULL;
+    }
+
+    // Decodes a file once, maxVoices caps how many copies may overlap
+    SoundEffect LoadEffect(const char* fileName, int maxVoices = AUDIO_DEFAULT_VOICES_PER_SOUND)
+    {
+        Wave wave = LoadWave(fileName);
+        SoundEffect effect = LoadEffectFromWave(wave, maxVoices);
+        UnloadWave(wave);
+        return effect;
+    }
+
+    // Cheap when the wave is already in the mixer format, as AssetManager delivers effects, otherwise this
+    // resamples on the calling thread
+    SoundEffect LoadEffectFromWave(Wave wave, int maxVoices = AUDIO_DEFAULT_VOICES_PER_SOUND)
+    {
+        SoundEffect effect;
+        if (wave.data == nullptr || wave.frameCount == 0) return effect;
+
+        Wave converted = WaveCopy(wave);
+        WaveFormat(&converted, AUDIO_SAMPLE_RATE, 32, AUDIO_CHANNELS);
+        float* samples = LoadWaveSamples(converted);
+
+        SoundClip clip;
+        clip.frameCount = converted.frameCount;
+        clip.samples.assign(samples, samples + converted.frameCount * AUDIO_CHANNELS);
+        clip.maxVoices = maxVoices > 0 ? maxVoices : 1;
+        UnloadWaveSamples(samples);
+        UnloadWave(converted);
+
+        // Deque so clips already referenced by voices never move
+        mClips.push_back(std::move(clip));
+        effect.id = (int)mClips.size() - 1;
+        return effect;
+    }
+
+    // Queues a play, pan runs from 0 (left) to 1 (right). Safe to call at any rate from the main thread.
+    bool Play(SoundEffect effect, float volume = 1.0f, float pan = 0.5f)
+    {
+        if (effect.id < 0 || effect.id >= (int)mClips.size()) return false;
+
+        // Constant power pan
+        const float angle = (pan < 0.0f ? 0.0f : (pan > 1.0f ? 1.0f : pan)) * PI * 0.5f;
+        PlayCommand command;
+        command.clip = &mClips[effect.id];
+        command.gainLeft = volume * cosf(angle);
+        command.gainRight = volume * sinf(angle);
+        return mCommands.TryPush(command);
+    }
+
+    // Voices playing as of the last mix
+    int ActiveVoices() const
+    {
+        return mActiveVoices.load(std::memory_order_relaxed);
+    }
+
+    // Renders frames of interleaved stereo into out, runs on the audio thread unless the output is null
+    void Mix(float* out, uint32_t frames)
+    {
+        PlayCommand command;
+        while (mCommands.TryPop(command))
+            Start(command);
+
+        memset(out, 0, frames * AUDIO_CHANNELS * sizeof(float));
+        int active = 0;
+        for (Voice& voice : mVoices)
+        {
+            if (voice.clip == nullptr) continue;
+
+            uint32_t remaining = voice.clip->frameCount - voice.position;
+            uint32_t count = remaining < frames ? remaining : frames;
+            MixVoice(out, voice.clip->samples.data() + voice.position * AUDIO_CHANNELS, count, voice.gainLeft, voice.gainRight);
+
+            voice.position += count;
+            if (voice.position >= voice.clip->frameCount) voice.clip = nullptr;
+            else active++;
+        }
+        ClampSamples(out, frames * AUDIO_CHANNELS);
+        mActiveVoices.store(active, std::memory_order_relaxed);
+    }
+
+private:
+    // Free voice if the clip is under its cap, otherwise the oldest voice of the same clip, otherwise the oldest voice
+    void Start(const PlayCommand& command)
+    {
+        Voice* freeVoice = nullptr;
+        Voice* oldestOverall = &mVoices[0];
+        Voice* oldestSame = nullptr;
+        int sameCount = 0;
+        for (Voice& voice : mVoices)
+        {
+            if (voice.clip == nullptr)
+            {
+                if (freeVoice == nullptr) freeVoice = &voice;
+                continue;
+            }
+
+            if (voice.started < oldestOverall->started || oldestOverall->clip == nullptr) oldestOverall = &voice;
+            if (voice.clip == command.clip)
+            {
+                sameCount++;
+                if (oldestSame == nullptr || voice.started < oldestSame->started) oldestSame = &voice;
+            }
+        }
+
+        Voice* target = sameCount >= command.clip->maxVoices ? oldestSame :
+            (freeVoice != nullptr ? freeVoice : oldestOverall);
+        target->clip = command.clip;
+        target->position = 0;
+        target->started = ++mStarted;
+        target->gainLeft = command.gainLeft;
+        target->gainRight = command.gainRight;
+    }
+
+    static AudioMixer*& ActiveMixer()
+    {
+        static AudioMixer* mixer = nullptr;
+        return mixer;
+    }
+
+    static void StreamCallback(void* buffer, unsigned int frames)
+    {
+        AudioMixer* mixer = ActiveMixer();
+        if (mixer != nullptr) mixer->Mix((float*)buffer, frames);
+        else memset(buffer, 0, frames * AUDIO_CHANNELS * sizeof(float));
+    }
+
+    std::deque<SoundClip> mClips;
+    LockFreeQueue<PlayCommand> mCommands;
+    Voice mVoices[AUDIO_MAX_VOICES];
+    uint64_t mStarted = 0;
+    std::atomic<int> mActiveVoices{ 0 };
+
+    AudioOutput mOutput;
+    AudioStream mStream{};
+};
@@ -0,0 +1,659 @@
+#pragma once
+#include "raylib.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <xmmintrin.h>
+
+// Regions are sized to hold about this many proxies each. Each region sorts only the proxies that overlap it,
+// which keeps bodies from passing each other on every frame the way they would along one axis of a big world.
+#define BROADPHASE_REGION_PROXIES 32
+
+// Regions are at least this many average proxies across, so few proxies straddle a border
+#define BROADPHASE_REGION_SPAN 16
+
+// How many updates go by between checking whether the region size still fits
+#define BROADPHASE_RESIZE_INTERVAL 64
+
+// How many endpoints ahead Refresh fetches proxy bounds
+#define BROADPHASE_PREFETCH 8
+
+// Endpoint bit marking a min, so at equal values maxes sort first and touching bounds never overlap
+#define BROADPHASE_MIN_BIT (1ull << 31)
+
+// Two proxies whose bounds overlap, a < b
+struct BroadphasePair
+{
+    int a;
+    int b;
+};
+
+// Incremental sort and sweep over body bounds. The world is split into square regions and every proxy is listed
+// in each region it overlaps, where both its ends stay sorted on x and on y between frames. An update is an
+// insertion sort per region and axis that only does work for bodies that moved past each other. A pair can only
+// start or stop overlapping in a region when one proxy's min passes the other's max there, so those swaps are
+// the add and remove events and pairs that didn't change are never looked at. Pairs count the regions they
+// overlap in and are reported while that's above zero.
+class SweepAndPrune
+{
+public:
+    // Returns a stable id, valid until the proxy is removed. Pairs with it are reported by the next Update.
+    int Insert(Rectangle bounds)
+    {
+        int id;
+        if (mFreeIds.empty())
+        {
+            id = (int)mAlive.size();
+            mAlive.push_back(false);
+            mBounds[0].push_back({});
+            mBounds[1].push_back({});
+            mRanges.push_back(EmptyRange());
+        }
+        else
+        {
+            id = mFreeIds.back();
+            mFreeIds.pop_back();
+        }
+
+        mAlive[id] = true;
+        SetBounds(id, bounds);
+        mCount++;
+        return id;
+    }
+
+    // Pairs with the proxy are reported removed by the next Update, after which the id may be reused
+    void Remove(int id)
+    {
+        if (!Contains(id)) return;
+
+        mAlive[id] = false;
+        mRemovedIds.push_back(id);
+        mCount--;
+    }
+
+    void Move(int id, Rectangle bounds)
+    {
+        if (!Contains(id)) return;
+        SetBounds(id, bounds);
+    }
+
+    // Re-sorts after inserts, moves and removals and records which pairs started or stopped overlapping.
+    // Touching bounds don't overlap, the same as CheckCollisionRecs.
+    void Update()
+    {
+        mAdded.clear();
+        mRemoved.clear();
+        mResized = false;
+        if (mUpdates++ % BROADPHASE_RESIZE_INTERVAL == 0 || mRegionScale == 0.0f) ResizeRegions();
+
+        // Each axis is judged against the other as it's currently sorted. Proxies leave regions between the
+        // two and enter them once both are sorted, so the sorts only ever see proxies that stay.
+        SortRegions(0);
+        FindCrossings();
+        LeaveRegions();
+        SortRegions(1);
+        CommitY();
+        EnterRegions();
+        if (mResized) RemoveUncountedPairs();
+
+        RemoveEmptyRegions();
+        CancelEvents();
+        mFreeIds.insert(mFreeIds.end(), mRemovedIds.begin(), mRemovedIds.end());
+        mRemovedIds.clear();
+    }
+
+    bool Contains(int id) const
+    {
+        return id >= 0 && id < (int)mAlive.size() && mAlive[id];
+    }
+
+    Rectangle Get(int id) const
+    {
+        const AxisBounds& x = mBounds[0][id];
+        const AxisBounds& y = mBounds[1][id];
+        return { x.min, y.min, x.max - x.min, y.max - y.min };
+    }
+
+    int Count() const
+    {
+        return mCount;
+    }
+
+    // Every overlapping pair as of the last Update, in no particular order
+    const std::vector<BroadphasePair>& Pairs() const
+    {
+        return mPairs;
+    }
+
+    // Pairs that started overlapping during the last Update
+    const std::vector<BroadphasePair>& AddedPairs() const
+    {
+        return mAdded;
+    }
+
+    // Pairs that stopped overlapping during the last Update
+    const std::vector<BroadphasePair>& RemovedPairs() const
+    {
+        return mRemoved;
+    }
+
+private:
+    // One end of a proxy on an axis. key sorts by value, then maxes before mins, then id. lo and hi are the
+    // proxy's bounds on the other axis as it's currently sorted, so most swaps are ruled out without looking
+    // the proxy up.
+    struct Endpoint
+    {
+        uint64_t key;
+        float lo;
+        float hi;
+    };
+
+    // A proxy's bounds on one axis as last set, and on the other axis as that axis is currently sorted.
+    // Everything Refresh reads for an endpoint sits together.
+    struct AxisBounds
+    {
+        float min;
+        float max;
+        float otherMin;
+        float otherMax;
+    };
+
+    // Regions a proxy overlaps, empty when x0 > x1
+    struct RegionRange
+    {
+        int x0, y0, x1, y1;
+    };
+
+    struct Region
+    {
+        int x;
+        int y;
+        std::vector<Endpoint> endpoints[2]; // two per proxy on each axis, sorted after every Update
+    };
+
+    // A proxy leaving or entering a region during an Update
+    struct Crossing
+    {
+        uint64_t region;
+        int id;
+    };
+
+    // How many regions a pair overlaps in, and the last pass and region that changed that so a pair found from
+    // both of its proxies only counts once
+    struct PairSlot
+    {
+        int index;                          // into mPairs
+        int regions;
+        unsigned int pass;
+        int region;
+    };
+
+    void SetBounds(int id, Rectangle bounds)
+    {
+        mBounds[0][id].min = bounds.x;
+        mBounds[0][id].max = bounds.x + bounds.width;
+        mBounds[1][id].min = bounds.y;
+        mBounds[1][id].max = bounds.y + bounds.height;
+    }
+
+    static RegionRange EmptyRange()
+    {
+        return { 0, 0, -1, -1 };
+    }
+
+    static bool InRange(const RegionRange& range, int x, int y)
+    {
+        return x >= range.x0 && x <= range.x1 && y >= range.y0 && y <= range.y1;
+    }
+
+    // floorf without the library call, bounds are well inside int range once divided by the region size
+    int RegionCoord(float value) const
+    {
+        const float scaled = value * mRegionScale;
+        const int truncated = (int)scaled;
+        return truncated - (scaled < (float)truncated);
+    }
+
+    static uint64_t RegionKey(int x, int y)
+    {
+        return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+    }
+
+    static uint64_t SortKey(float value, int id, bool isMin)
+    {
+        uint32_t bits;
+        value += 0.0f;  // -0 sorts with 0
+        memcpy(&bits, &value, sizeof(bits));
+        bits = bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+        return (uint64_t)bits << 32 | (isMin ? BROADPHASE_MIN_BIT : 0) | (uint32_t)id;
+    }
+
+    static int EndpointId(uint64_t key)
+    {
+        return (int)(key & (BROADPHASE_MIN_BIT - 1));
+    }
+
+    static bool KeyLess(const Endpoint& a, const Endpoint& b)
+    {
+        return a.key < b.key;
+    }
+
+    // Picks the region size for the proxies there are now. Changing it lists every proxy afresh, with the
+    // pairs' region counts starting over.
+    void ResizeRegions()
+    {
+        Vector2 low = { FLT_MAX, FLT_MAX }, high = { -FLT_MAX, -FLT_MAX };
+        double extent = 0.0;
+        int count = 0;
+        for (size_t id = 0; id < mAlive.size(); id++)
+        {
+            if (!mAlive[id]) continue;
+
+            const AxisBounds& x = mBounds[0][id];
+            const AxisBounds& y = mBounds[1][id];
+            low = { std::min(low.x, x.min), std::min(low.y, y.min) };
+            high = { std::max(high.x, x.max), std::max(high.y, y.max) };
+            extent += (x.max - x.min) + (y.max - y.min);
+            count++;
+        }
+        if (count == 0) return;
+
+        const double area = (double)(high.x - low.x) * (high.y - low.y);
+        const double size = std::max(sqrt(BROADPHASE_REGION_PROXIES * area / count),
+            BROADPHASE_REGION_SPAN * extent / (2.0 * count));
+        if (!(size > 0.0) || (mRegionScale > 0.0f && size * mRegionScale > 0.67 && size * mRegionScale < 1.5)) return;
+
+        // A power of two, so scaling by it is exact
+        mRegionScale = 1.0f / exp2f(roundf(log2f((float)size)));
+        mRegions.clear();
+        mRegionSlots.clear();
+        std::fill(mRanges.begin(), mRanges.end(), EmptyRange());
+        for (auto& slot : mPairSlots)
+            slot.second.regions = 0;
+        mResized = true;
+    }
+
+    // After the region size changed, pairs that no longer overlap anywhere are the ones that stopped overlapping
+    void RemoveUncountedPairs()
+    {
+        for (int i = (int)mPairs.size() - 1; i >= 0; i--)
+        {
+            const BroadphasePair pair = mPairs[i];
+            if (mPairSlots[Key(pair.a, pair.b)].regions > 0) continue;
+
+            mRemoved.push_back(pair);
+            mPairSlots.erase(Key(pair.a, pair.b));
+            if (i != (int)mPairs.size() - 1)
+            {
+                mPairs[i] = mPairs.back();
+                mPairSlots[Key(mPairs[i].a, mPairs[i].b)].index = i;
+            }
+            mPairs.pop_back();
+        }
+    }
+
+    // Sorts y by where x is now, and works out which regions every proxy overlaps now and lists the ones it
+    // left and entered
+    void FindCrossings()
+    {
+        mLeaving.clear();
+        mEntering.clear();
+        mWidest[0] = mWidest[1] = 0.0f;
+        for (size_t id = 0; id < mAlive.size(); id++)
+        {
+            const AxisBounds& x = mBounds[0][id];
+            AxisBounds& y = mBounds[1][id];
+            y.otherMin = x.min;
+            y.otherMax = x.max;
+            mWidest[0] = std::max(mWidest[0], x.max - x.min);
+            mWidest[1] = std::max(mWidest[1], y.max - y.min);
+
+            RegionRange next = EmptyRange();
+            if (mAlive[id]) next = { RegionCoord(x.min), RegionCoord(y.min), RegionCoord(x.max), RegionCoord(y.max) };
+
+            RegionRange& range = mRanges[id];
+            if (next.x0 == range.x0 && next.y0 == range.y0 && next.x1 == range.x1 && next.y1 == range.y1) continue;
+
+            for (int cellY = range.y0; cellY <= range.y1; cellY++)
+            {
+                for (int cellX = range.x0; cellX <= range.x1; cellX++)
+                {
+                    if (!InRange(next, cellX, cellY)) mLeaving.push_back({ RegionKey(cellX, cellY), (int)id });
+                }
+            }
+            for (int cellY = next.y0; cellY <= next.y1; cellY++)
+            {
+                for (int cellX = next.x0; cellX <= next.x1; cellX++)
+                {
+                    if (!InRange(range, cellX, cellY)) mEntering.push_back({ RegionKey(cellX, cellY), (int)id });
+                }
+            }
+            range = next;
+        }
+    }
+
+    void SortRegions(int axis)
+    {
+        mPass++;
+        for (int region = 0; region < (int)mRegions.size(); region++)
+        {
+            const Region* next = region + 1 < (int)mRegions.size() ? &mRegions[region + 1] : nullptr;
+            Refresh(mRegions[region], next, axis);
+            Sort(region, axis);
+        }
+    }
+
+    // Repacks a region's endpoints on an axis with their proxies' current bounds, leaving them in the old
+    // order. Fetches run on into the next region so its first endpoints don't wait either.
+    void Refresh(Region& region, const Region* next, int axis)
+    {
+        const AxisBounds* bounds = mBounds[axis].data();
+        Endpoint* endpoints = region.endpoints[axis].data();
+        const int count = (int)region.endpoints[axis].size();
+        const Endpoint* ahead = next ? next->endpoints[axis].data() : nullptr;
+        const int aheadCount = next ? std::min((int)next->endpoints[axis].size(), BROADPHASE_PREFETCH) : 0;
+        for (int i = 0; i < count; i++)
+        {
+            const int fetch = i + BROADPHASE_PREFETCH;
+            if (fetch < count)
+                _mm_prefetch((const char*)&bounds[EndpointId(endpoints[fetch].key)], _MM_HINT_T0);
+            else if (fetch - count < aheadCount)
+                _mm_prefetch((const char*)&bounds[EndpointId(ahead[fetch - count].key)], _MM_HINT_T0);
+
+            const uint64_t key = endpoints[i].key;
+            const int id = EndpointId(key);
+            const bool isMin = (key & BROADPHASE_MIN_BIT) != 0;
+            const AxisBounds& proxy = bounds[id];
+            const float ends[2] = { proxy.max, proxy.min };    // indexed, a branch here would be a coin toss
+            endpoints[i] = { SortKey(ends[isMin], id, isMin), proxy.otherMin, proxy.otherMax };
+        }
+    }
+
+    // x is sorted by where y is now
+    void CommitY()
+    {
+        AxisBounds* x = mBounds[0].data();
+        const AxisBounds* y = mBounds[1].data();
+        for (size_t id = 0; id < mAlive.size(); id++)
+        {
+            x[id].otherMin = y[id].min;
+            x[id].otherMax = y[id].max;
+        }
+    }
+
+    // Whether swapping a and b can change their pair: one is a min and the other a max, and they overlap on the
+    // other axis as it's currently sorted
+    static bool Crosses(const Endpoint& a, const Endpoint& b)
+    {
+        return (((a.key ^ b.key) & BROADPHASE_MIN_BIT) != 0) & (a.lo < b.hi) & (b.lo < a.hi);
+    }
+
+    // Insertion sort, nearly free when little moved past anything since the last sort. Each swap of a min and a
+    // max of different proxies changed their overlap on this axis.
+    void Sort(int region, int axis)
+    {
+        Endpoint* endpoints = mRegions[region].endpoints[axis].data();
+        const int count = (int)mRegions[region].endpoints[axis].size();
+        for (int i = 1; i < count; i++)
+        {
+            if (endpoints[i].key >= endpoints[i - 1].key) continue;
+
+            const Endpoint key = endpoints[i];
+            int j = i - 1;
+            do
+            {
+                if (Crosses(key, endpoints[j]))
+                    Crossed(region, axis, EndpointId(key.key), EndpointId(endpoints[j].key));
+                endpoints[j + 1] = endpoints[j];
+                j--;
+            } while (j >= 0 && key.key < endpoints[j].key);
+            endpoints[j + 1] = key;
+        }
+    }
+
+    // Counts the region in or out of the pair if the swap changed whether they overlap there
+    void Crossed(int region, int axis, int a, int b)
+    {
+        if (a == b) return;
+
+        const AxisBounds& p = mBounds[axis][a];
+        const AxisBounds& q = mBounds[axis][b];
+        const AxisBounds& sortedP = mBounds[1 - axis][a];
+        const AxisBounds& sortedQ = mBounds[1 - axis][b];
+        const bool was = sortedP.otherMin < sortedQ.otherMax && sortedQ.otherMin < sortedP.otherMax;
+        const bool is = p.min < q.max && q.min < p.max;
+        if (was == is) return;
+
+        if (is)
+            CountIn(a, b, region);
+        else
+            CountOut(a, b, region);
+    }
+
+    // Calls visit with every other proxy in the region overlapping id on an axis as it's now sorted and on the
+    // other as it's currently sorted. Only mins within twice the widest proxy of id's are looked at, so rounding
+    // can't hide one.
+    template <typename Visit>
+    void ForOverlaps(const Region& region, int axis, int id, Visit visit) const
+    {
+        const AxisBounds& p = mBounds[axis][id];
+        const std::vector<Endpoint>& endpoints = region.endpoints[axis];
+        const uint64_t last = SortKey(p.max, 0, false);
+        auto it = std::lower_bound(endpoints.begin(), endpoints.end(),
+            Endpoint{ SortKey(p.min - 2.0f * mWidest[axis], 0, false), 0.0f, 0.0f }, KeyLess);
+        for (; it != endpoints.end() && it->key < last; ++it)
+        {
+            if (!(it->key & BROADPHASE_MIN_BIT) || !(it->lo < p.otherMax && p.otherMin < it->hi)) continue;
+
+            const int other = EndpointId(it->key);
+            if (other != id && p.min < mBounds[axis][other].max) visit(other);
+        }
+    }
+
+    // Between the two sorts x is sorted by where proxies are now and y by where they were, which is what every
+    // pair in a region is counted by at that point. Proxies leaving count out of what they overlap there and
+    // their endpoints are taken out.
+    void LeaveRegions()
+    {
+        mPass++;
+        std::sort(mLeaving.begin(), mLeaving.end(), [](const Crossing& a, const Crossing& b)
+        {
+            return a.region < b.region;
+        });
+        for (size_t first = 0, last = 0; first < mLeaving.size(); first = last)
+        {
+            const int index = mRegionSlots.find(mLeaving[first].region)->second;
+            Region& region = mRegions[index];
+            for (last = first; last < mLeaving.size() && mLeaving[last].region == mLeaving[first].region; last++)
+            {
+                const int id = mLeaving[last].id;
+                ForOverlaps(region, 0, id, [&](int other) { CountOut(id, other, index); });
+            }
+
+            // x keys are fresh from this update's sort, y keys still hold what y was sorted by
+            for (int axis = 0; axis < 2; axis++)
+            {
+                std::vector<Endpoint>& endpoints = region.endpoints[axis];
+                mErase.clear();
+                for (size_t i = first; i < last; i++)
+                {
+                    const int id = mLeaving[i].id;
+                    const AxisBounds& x = mBounds[0][id];
+                    const float min = axis == 0 ? x.min : x.otherMin;
+                    const float max = axis == 0 ? x.max : x.otherMax;
+                    for (const uint64_t key : { SortKey(min, id, true), SortKey(max, id, false) })
+                    {
+                        mErase.push_back((int)(std::lower_bound(endpoints.begin(), endpoints.end(),
+                            Endpoint{ key, 0.0f, 0.0f }, KeyLess) - endpoints.begin()));
+                    }
+                }
+                std::sort(mErase.begin(), mErase.end());
+                size_t kept = mErase[0];
+                for (size_t i = 0; i < mErase.size(); i++)
+                {
+                    const size_t end = i + 1 < mErase.size() ? (size_t)mErase[i + 1] : endpoints.size();
+                    std::copy(endpoints.begin() + mErase[i] + 1, endpoints.begin() + end, endpoints.begin() + kept);
+                    kept += end - mErase[i] - 1;
+                }
+                endpoints.resize(kept);
+            }
+        }
+    }
+
+    // Both axes are sorted by where proxies are now. Entering proxies are merged into each region's endpoints
+    // and count in what they overlap there.
+    void EnterRegions()
+    {
+        mPass++;
+        std::sort(mEntering.begin(), mEntering.end(), [](const Crossing& a, const Crossing& b)
+        {
+            return a.region < b.region;
+        });
+        for (size_t first = 0, last = 0; first < mEntering.size(); first = last)
+        {
+            const auto inserted = mRegionSlots.insert({ mEntering[first].region, (int)mRegions.size() });
+            if (inserted.second)
+            {
+                mRegions.push_back({});
+                mRegions.back().x = (int)(int32_t)(mEntering[first].region >> 32);
+                mRegions.back().y = (int)(int32_t)(uint32_t)mEntering[first].region;
+            }
+            const int index = inserted.first->second;
+            Region& region = mRegions[index];
+
+            for (last = first; last < mEntering.size() && mEntering[last].region == mEntering[first].region; last++)
+                ;
+            for (int axis = 0; axis < 2; axis++)
+            {
+                std::vector<Endpoint>& endpoints = region.endpoints[axis];
+                const size_t sorted = endpoints.size();
+                for (size_t i = first; i < last; i++)
+                {
+                    const int id = mEntering[i].id;
+                    const AxisBounds& bounds = mBounds[axis][id];
+                    endpoints.push_back({ SortKey(bounds.min, id, true), bounds.otherMin, bounds.otherMax });
+                    endpoints.push_back({ SortKey(bounds.max, id, false), bounds.otherMin, bounds.otherMax });
+                }
+                std::sort(endpoints.begin() + sorted, endpoints.end(), KeyLess);
+                std::inplace_merge(endpoints.begin(), endpoints.begin() + sorted, endpoints.end(), KeyLess);
+            }
+            for (size_t i = first; i < last; i++)
+            {
+                const int id = mEntering[i].id;
+                ForOverlaps(region, 1, id, [&](int other) { CountIn(id, other, index); });
+            }
+        }
+    }
+
+    void RemoveEmptyRegions()
+    {
+        for (int i = (int)mRegions.size() - 1; i >= 0; i--)
+        {
+            if (!mRegions[i].endpoints[0].empty()) continue;
+
+            mRegionSlots.erase(RegionKey(mRegions[i].x, mRegions[i].y));
+            if (i != (int)mRegions.size() - 1)
+            {
+                mRegions[i] = std::move(mRegions.back());
+                mRegionSlots[RegionKey(mRegions[i].x, mRegions[i].y)] = i;
+            }
+            mRegions.pop_back();
+        }
+    }
+
+    // A pair can be added on one axis or region and removed on another in the same update, or the other way
+    // round. Those never changed as far as callers are concerned.
+    void CancelEvents()
+    {
+        if (mAdded.empty() || mRemoved.empty()) return;
+
+        auto less = [](const BroadphasePair& x, const BroadphasePair& y) { return Key(x.a, x.b) < Key(y.a, y.b); };
+        std::sort(mAdded.begin(), mAdded.end(), less);
+        std::sort(mRemoved.begin(), mRemoved.end(), less);
+        size_t added = 0, removed = 0, keptAdded = 0, keptRemoved = 0;
+        while (added < mAdded.size() || removed < mRemoved.size())
+        {
+            if (removed == mRemoved.size() || (added < mAdded.size() && less(mAdded[added], mRemoved[removed])))
+                mAdded[keptAdded++] = mAdded[added++];
+            else if (added == mAdded.size() || less(mRemoved[removed], mAdded[added]))
+                mRemoved[keptRemoved++] = mRemoved[removed++];
+            else
+                added++, removed++;
+        }
+        mAdded.resize(keptAdded);
+        mRemoved.resize(keptRemoved);
+    }
+
+    static uint64_t Key(int a, int b)
+    {
+        return ((uint64_t)(uint32_t)a << 32) | (uint32_t)b;
+    }
+
+    void CountIn(int a, int b, int region)
+    {
+        if (a > b) std::swap(a, b);
+        const auto inserted = mPairSlots.insert({ Key(a, b), { (int)mPairs.size(), 0, 0, -1 } });
+        PairSlot& slot = inserted.first->second;
+        if (slot.pass == mPass && slot.region == region) return;
+
+        slot.pass = mPass;
+        slot.region = region;
+
+        // A pair still listed with no regions is one being counted again after a resize
+        if (slot.regions++ > 0 || !inserted.second) return;
+
+        mPairs.push_back({ a, b });
+        mAdded.push_back({ a, b });
+    }
+
+    void CountOut(int a, int b, int region)
+    {
+        if (a > b) std::swap(a, b);
+        auto it = mPairSlots.find(Key(a, b));
+        if (it == mPairSlots.end() || (it->second.pass == mPass && it->second.region == region)) return;
+
+        it->second.pass = mPass;
+        it->second.region = region;
+        if (--it->second.regions > 0) return;
+
+        mRemoved.push_back({ a, b });
+
+        // Swap the last pair into the hole
+        const int index = it->second.index;
+        mPairSlots.erase(it);
+        if (index != (int)mPairs.size() - 1)
+        {
+            mPairs[index] = mPairs.back();
+            mPairSlots[Key(mPairs[index].a, mPairs[index].b)].index = index;
+        }
+        mPairs.pop_back();
+    }
+
+    std::vector<bool> mAlive;
+    std::vector<AxisBounds> mBounds[2];     // x and y of every proxy
+    std::vector<RegionRange> mRanges;       // regions each proxy is listed in
+    std::vector<int> mFreeIds;
+    std::vector<int> mRemovedIds;           // freed by the next Update
+    int mCount = 0;
+    float mWidest[2] = {};                  // widest proxy on each axis
+    float mRegionScale = 0.0f;              // one over the region size
+    unsigned int mUpdates = 0;
+    bool mResized = false;                  // during the Update that changed the region size
+
+    std::vector<Region> mRegions;
+    std::unordered_map<uint64_t, int> mRegionSlots;   // index into mRegions
+    std::vector<Crossing> mLeaving;
+    std::vector<Crossing> mEntering;
+    std::vector<int> mErase;
+
+    std::vector<BroadphasePair> mPairs;
+    std::unordered_map<uint64_t, PairSlot> mPairSlots;
+    std::vector<BroadphasePair> mAdded;
+    std::vector<BroadphasePair> mRemoved;
+    unsigned int mPass = 0;                 // bumped by every sort and by leaving and entering
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "raylib.h"
 #include "Math.h"
+#include "Fixed.h"
 #include <array>
 #include <vector>
 #include <algorithm>
@@ -11,6 +12,18 @@ struct Circle
     float radius;
 };
 
+// Closest point on or inside rectangle to point
+Vector2 NearestPointRec(Vector2 point, Rectangle rectangle)
+{
+    return { Clamp(point.x, rectangle.x, rectangle.x + rectangle.width),
+        Clamp(point.y, rectangle.y, rectangle.y + rectangle.height) };
+}
+
+bool CheckCollisionCircleRec(Circle circle, Rectangle rectangle)
+{
+    return DistanceSqr(NearestPointRec(circle.position, rectangle), circle.position) <= circle.radius * circle.radius;
+}
+
 bool CheckCollisionLineCircle(Vector2 lineStart, Vector2 lineEnd, Circle circle)
 {
     Vector2 nearest = NearestPoint(lineStart, lineEnd, circle.position);
@@ -146,3 +159,170 @@ bool NearestIntersection(Vector2 lineStart, Vector2 lineEnd, const std::vector<R
 
     return collision;
 }
+
+// Rectangle rotated about its centre. axis is the unit direction of the box's local x, local y is
+// axis turned a quarter clockwise on screen.
+struct OrientedBox
+{
+    Vector2 center;
+    Vector2 halfExtents;
+    Vector2 axis;
+};
+
+// Same placement as DrawRectanglePro: rectangle's position is where origin ends up and rotation is in degrees
+OrientedBox OrientedBoxFromRec(Rectangle rectangle, Vector2 origin, float rotation)
+{
+    const Vector2 axis = Direction(rotation * DEG2RAD);
+    const Vector2 offset{ rectangle.width * 0.5f - origin.x, rectangle.height * 0.5f - origin.y };
+    const Vector2 normal{ -axis.y, axis.x };
+    return { { rectangle.x + axis.x * offset.x + normal.x * offset.y, rectangle.y + axis.y * offset.x + normal.y * offset.y },
+        { rectangle.width * 0.5f, rectangle.height * 0.5f }, axis };
+}
+
+// Corners in winding order starting from local (-x, -y)
+void GetOrientedBoxCorners(const OrientedBox& box, Vector2 corners[4])
+{
+    const Vector2 x = box.axis * box.halfExtents.x;
+    const Vector2 y = Vector2{ -box.axis.y, box.axis.x } * box.halfExtents.y;
+    corners[0] = box.center - x - y;
+    corners[1] = box.center + x - y;
+    corners[2] = box.center + x + y;
+    corners[3] = box.center - x + y;
+}
+
+// Axis-aligned bounds, for broadphase queries
+Rectangle GetOrientedBoxBounds(const OrientedBox& box)
+{
+    const float extentX = box.halfExtents.x * fabsf(box.axis.x) + box.halfExtents.y * fabsf(box.axis.y);
+    const float extentY = box.halfExtents.x * fabsf(box.axis.y) + box.halfExtents.y * fabsf(box.axis.x);
+    return { box.center.x - extentX, box.center.y - extentY, extentX * 2.0f, extentY * 2.0f };
+}
+
+// Separating axis test on the two world axes and the box's two axes. Straight-line arithmetic with no early
+// outs so it vectorises when run over arrays of rectangles.
+bool CheckCollisionOBBRec(const OrientedBox& box, Rectangle rectangle)
+{
+    const Vector2 u = box.axis;
+    const Vector2 v{ -u.y, u.x };
+    const Vector2 half{ rectangle.width * 0.5f, rectangle.height * 0.5f };
+    const Vector2 d{ rectangle.x + half.x - box.center.x, rectangle.y + half.y - box.center.y };
+
+    const float ux = fabsf(u.x), uy = fabsf(u.y);
+    const bool separatedX = fabsf(d.x) > half.x + box.halfExtents.x * ux + box.halfExtents.y * uy;
+    const bool separatedY = fabsf(d.y) > half.y + box.halfExtents.x * uy + box.halfExtents.y * ux;
+    const bool separatedU = fabsf(Dot(d, u)) > box.halfExtents.x + half.x * ux + half.y * uy;
+    const bool separatedV = fabsf(Dot(d, v)) > box.halfExtents.y + half.x * uy + half.y * ux;
+    return !(separatedX | separatedY | separatedU | separatedV);
+}
+
+// Separating axis test on the four box axes
+bool CheckCollisionOBBs(const OrientedBox& a, const OrientedBox& b)
+{
+    const Vector2 axes[4] = { a.axis, { -a.axis.y, a.axis.x }, b.axis, { -b.axis.y, b.axis.x } };
+    const Vector2 d = b.center - a.center;
+
+    bool separated = false;
+    for (const Vector2& axis : axes)
+    {
+        const float extentA = a.halfExtents.x * fabsf(Dot(a.axis, axis)) + a.halfExtents.y * fabsf(Cross(a.axis, axis));
+        const float extentB = b.halfExtents.x * fabsf(Dot(b.axis, axis)) + b.halfExtents.y * fabsf(Cross(b.axis, axis));
+        separated |= fabsf(Dot(d, axis)) > extentA + extentB;
+    }
+    return !separated;
+}
+
+// Clamps the circle centre into the box's local frame
+bool CheckCollisionOBBCircle(const OrientedBox& box, Circle circle)
+{
+    const Vector2 d = circle.position - box.center;
+    const Vector2 local{ Dot(d, box.axis), Cross(box.axis, d) };
+    const Vector2 nearest = Clamp(local, Negate(box.halfExtents), box.halfExtents);
+    return DistanceSqr(local, nearest) <= circle.radius * circle.radius;
+}
+
+// Slab test in the box's local frame. poi is where the segment enters the box, lineStart if it starts inside.
+bool CheckCollisionLineOBB(Vector2 lineStart, Vector2 lineEnd, const OrientedBox& box, Vector2& poi)
+{
+    const Vector2 d = lineStart - box.center;
+    const Vector2 delta = lineEnd - lineStart;
+    const float start[2] = { Dot(d, box.axis), Cross(box.axis, d) };
+    const float direction[2] = { Dot(delta, box.axis), Cross(box.axis, delta) };
+    const float half[2] = { box.halfExtents.x, box.halfExtents.y };
+
+    float enter = 0.0f, exit = 1.0f;
+    for (int i = 0; i < 2; i++)
+    {
+        if (fabsf(direction[i]) < 1e-9f)
+        {
+            if (fabsf(start[i]) > half[i]) return false;
+            continue;
+        }
+
+        const float inverse = 1.0f / direction[i];
+        float near = (-half[i] - start[i]) * inverse;
+        float far = (half[i] - start[i]) * inverse;
+        if (near > far) std::swap(near, far);
+        enter = std::max(enter, near);
+        exit = std::min(exit, far);
+        if (enter > exit) return false;
+    }
+
+    poi = lineStart + delta * enter;
+    return true;
+}
+
+bool CheckCollisionLineOBB(Vector2 lineStart, Vector2 lineEnd, const OrientedBox& box)
+{
+    Vector2 poi;
+    return CheckCollisionLineOBB(lineStart, lineEnd, box, poi);
+}
+
+//----------------------------------------------------------------------------------
+// Scalar generic forms for the lockstep simulation. V is Vector2 or a FixedVector2, boxes are given by their min
+// and max corners since Rectangle is float only.
+//----------------------------------------------------------------------------------
+
+// Closest point on or inside the box to point
+template<typename V>
+V NearestPointBox(V point, V min, V max)
+{
+    return { Clamp(point.x, min.x, max.x), Clamp(point.y, min.y, max.y) };
+}
+
+template<typename V, typename T>
+bool CheckCollisionCircleBox(V center, T radius, V min, V max)
+{
+    return DistanceSqr(NearestPointBox(center, min, max), center) <= radius * radius;
+}
+
+template<typename V, typename T>
+bool CheckCollisionLineCircle(V lineStart, V lineEnd, V center, T radius)
+{
+    return DistanceSqr(NearestPoint(lineStart, lineEnd, center), center) <= radius * radius;
+}
+
+template<typename V>
+bool CheckCollisionPointBox(V point, V min, V max)
+{
+    return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y;
+}
+
+// Whether segments AB and CD cross or touch. Only signs of cross products are compared, so it's exact in fixed
+// point as long as they don't saturate.
+template<typename V>
+bool CheckCollisionSegments(V a, V b, V c, V d)
+{
+    typedef decltype(Cross(a, b)) T;
+    const T zero = T();
+    const T abc = Cross(b - a, c - a), abd = Cross(b - a, d - a);
+    const T cda = Cross(d - c, a - c), cdb = Cross(d - c, b - c);
+    if (((abc > zero && abd < zero) || (abc < zero && abd > zero)) &&
+        ((cda > zero && cdb < zero) || (cda < zero && cdb > zero)))
+        return true;
+
+    // Touching, an endpoint lies on the other segment
+    return (abc == zero && CheckCollisionPointBox(c, V{ std::min(a.x, b.x), std::min(a.y, b.y) }, V{ std::max(a.x, b.x), std::max(a.y, b.y) })) ||
+        (abd == zero && CheckCollisionPointBox(d, V{ std::min(a.x, b.x), std::min(a.y, b.y) }, V{ std::max(a.x, b.x), std::max(a.y, b.y) })) ||
+        (cda == zero && CheckCollisionPointBox(a, V{ std::min(c.x, d.x), std::min(c.y, d.y) }, V{ std::max(c.x, d.x), std::max(c.y, d.y) })) ||
+        (cdb == zero && CheckCollisionPointBox(b, V{ std::min(c.x, d.x), std::min(c.y, d.y) }, V{ std::max(c.x, d.x), std::max(c.y, d.y) }));
+}
@@ -0,0 +1,475 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "Collision.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#define GJK_MAX_ITERATIONS 32
+#define EPA_MAX_ITERATIONS 32
+#define EPA_MAX_VERTICES (EPA_MAX_ITERATIONS + 4)
+
+// Relative tolerance for GJK and EPA convergence
+#define CONVEX_TOLERANCE 1e-5f
+
+// Convex polygon with counter-clockwise vertices (by Cross) and everything queries need precomputed
+struct ConvexPolygon
+{
+    std::vector<Vector2> vertices;
+    std::vector<Vector2> normals;   // outward unit normal of the edge from vertices[i] to vertices[i + 1]
+    Vector2 centroid{};
+    Rectangle bounds{};
+};
+
+// Convex hull of the points (monotone chain) with normals, centroid and bounds filled in
+ConvexPolygon ConvexPolygonFromPoints(const Vector2* points, int count)
+{
+    std::vector<Vector2> sorted(points, points + count);
+    std::sort(sorted.begin(), sorted.end(), [](Vector2 a, Vector2 b) { return a.x != b.x ? a.x < b.x : a.y < b.y; });
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), [](Vector2 a, Vector2 b) { return a.x == b.x && a.y == b.y; }), sorted.end());
+
+    ConvexPolygon polygon;
+    std::vector<Vector2>& hull = polygon.vertices;
+    const int n = (int)sorted.size();
+    if (n < 3)
+    {
+        hull = sorted;
+    }
+    else
+    {
+        hull.resize(n * 2);
+        int k = 0;
+        for (int i = 0; i < n; i++)
+        {
+            while (k >= 2 && Cross(hull[k - 1] - hull[k - 2], sorted[i] - hull[k - 2]) <= 0.0f) k--;
+            hull[k++] = sorted[i];
+        }
+        for (int i = n - 2, lower = k + 1; i >= 0; i--)
+        {
+            while (k >= lower && Cross(hull[k - 1] - hull[k - 2], sorted[i] - hull[k - 2]) <= 0.0f) k--;
+            hull[k++] = sorted[i];
+        }
+        hull.resize(k - 1);
+    }
+
+    float x0 = FLT_MAX, y0 = FLT_MAX, x1 = -FLT_MAX, y1 = -FLT_MAX;
+    Vector2 sum{};
+    for (size_t i = 0; i < hull.size(); i++)
+    {
+        const Vector2 edge = hull[(i + 1) % hull.size()] - hull[i];
+        polygon.normals.push_back(Normalize(Vector2{ edge.y, -edge.x }));
+        sum = sum + hull[i];
+        x0 = std::min(x0, hull[i].x);
+        y0 = std::min(y0, hull[i].y);
+        x1 = std::max(x1, hull[i].x);
+        y1 = std::max(y1, hull[i].y);
+    }
+    if (!hull.empty())
+    {
+        polygon.centroid = sum / (float)hull.size();
+        polygon.bounds = { x0, y0, x1 - x0, y1 - y0 };
+    }
+    return polygon;
+}
+
+ConvexPolygon ConvexPolygonFromRec(Rectangle rectangle)
+{
+    const Vector2 corners[4] = { { rectangle.x, rectangle.y }, { rectangle.x + rectangle.width, rectangle.y },
+        { rectangle.x + rectangle.width, rectangle.y + rectangle.height }, { rectangle.x, rectangle.y + rectangle.height } };
+    return ConvexPolygonFromPoints(corners, 4);
+}
+
+ConvexPolygon ConvexPolygonFromOBB(const OrientedBox& box)
+{
+    Vector2 corners[4];
+    GetOrientedBoxCorners(box, corners);
+    return ConvexPolygonFromPoints(corners, 4);
+}
+
+// Support points, the furthest point of a shape along direction. hint carries the last polygon vertex
+// between calls so each call only climbs a step or two from where the previous one ended.
+Vector2 Support(const ConvexPolygon& polygon, Vector2 direction, int& hint)
+{
+    const int count = (int)polygon.vertices.size();
+    if (count == 0) return polygon.centroid;
+
+    int best = hint >= 0 && hint < count ? hint : 0;
+    float bestDot = Dot(polygon.vertices[best], direction);
+    for (;;)
+    {
+        const int next = (best + 1) % count;
+        const int previous = (best + count - 1) % count;
+        const float nextDot = Dot(polygon.vertices[next], direction);
+        const float previousDot = Dot(polygon.vertices[previous], direction);
+        if (nextDot > bestDot)
+        {
+            best = next;
+            bestDot = nextDot;
+        }
+        else if (previousDot > bestDot)
+        {
+            best = previous;
+            bestDot = previousDot;
+        }
+        else
+        {
+            break;
+        }
+    }
+    hint = best;
+    return polygon.vertices[best];
+}
+
+Vector2 Support(Rectangle rectangle, Vector2 direction, int&)
+{
+    return { direction.x > 0.0f ? rectangle.x + rectangle.width : rectangle.x,
+        direction.y > 0.0f ? rectangle.y + rectangle.height : rectangle.y };
+}
+
+Vector2 Support(const Circle& circle, Vector2 direction, int&)
+{
+    return circle.position + Normalize(direction) * circle.radius;
+}
+
+Vector2 Support(const OrientedBox& box, Vector2 direction, int&)
+{
+    const Vector2 normal{ -box.axis.y, box.axis.x };
+    return box.center + box.axis * (Dot(direction, box.axis) > 0.0f ? box.halfExtents.x : -box.halfExtents.x) +
+        normal * (Dot(direction, normal) > 0.0f ? box.halfExtents.y : -box.halfExtents.y);
+}
+
+// Only a polygon built from no points has nothing to collide with
+bool IsEmptyShape(const ConvexPolygon& polygon)
+{
+    return polygon.vertices.empty();
+}
+
+template<typename Shape>
+bool IsEmptyShape(const Shape&)
+{
+    return false;
+}
+
+// Point of the Minkowski difference a - b along with the points of a and b that made it
+struct MinkowskiPoint
+{
+    Vector2 point;
+    Vector2 a;
+    Vector2 b;
+};
+
+template<typename ShapeA, typename ShapeB>
+struct MinkowskiDifference
+{
+    const ShapeA& a;
+    const ShapeB& b;
+    int hintA;
+    int hintB;
+
+    MinkowskiPoint Support(Vector2 direction)
+    {
+        MinkowskiPoint result;
+        result.a = ::Support(a, direction, hintA);
+        result.b = ::Support(b, Negate(direction), hintB);
+        result.point = result.a - result.b;
+        return result;
+    }
+};
+
+struct GjkResult
+{
+    bool overlapping;
+    float distance;     // 0 when overlapping
+    Vector2 pointA;     // closest points when apart
+    Vector2 pointB;
+    MinkowskiPoint simplex[3];
+    int simplexCount;
+};
+
+// Closest point to the origin on the simplex, which is reduced to the vertices that support it.
+// Returns false when the origin is inside a triangle.
+bool ReduceSimplex(MinkowskiPoint* simplex, int& count, float* weights, Vector2& closest)
+{
+    auto segment = [](const MinkowskiPoint& a, const MinkowskiPoint& b, float& t)
+    {
+        const Vector2 edge = b.point - a.point;
+        const float lengthSqr = LengthSqr(edge);
+        t = lengthSqr > 0.0f ? Clamp(-Dot(a.point, edge) / lengthSqr, 0.0f, 1.0f) : 0.0f;
+        return a.point + edge * t;
+    };
+
+    if (count == 1)
+    {
+        weights[0] = 1.0f;
+        closest = simplex[0].point;
+        return true;
+    }
+
+    if (count == 3)
+    {
+        const float area = Cross(simplex[1].point - simplex[0].point, simplex[2].point - simplex[0].point);
+        const float w0 = Cross(simplex[1].point, simplex[2].point);
+        const float w1 = Cross(simplex[2].point, simplex[0].point);
+        const float w2 = Cross(simplex[0].point, simplex[1].point);
+        if (area != 0.0f && w0 * area >= 0.0f && w1 * area >= 0.0f && w2 * area >= 0.0f) return false;
+
+        // Outside, keep the nearest edge
+        int bestEdge = 0;
+        float bestDistance = FLT_MAX;
+        for (int i = 0; i < 3; i++)
+        {
+            float t;
+            const float distance = LengthSqr(segment(simplex[i], simplex[(i + 1) % 3], t));
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                bestEdge = i;
+            }
+        }
+        const MinkowskiPoint a = simplex[bestEdge], b = simplex[(bestEdge + 1) % 3];
+        simplex[0] = a;
+        simplex[1] = b;
+        count = 2;
+    }
+
+    float t;
+    closest = segment(simplex[0], simplex[1], t);
+    if (t <= 0.0f)
+    {
+        count = 1;
+        weights[0] = 1.0f;
+    }
+    else if (t >= 1.0f)
+    {
+        simplex[0] = simplex[1];
+        count = 1;
+        weights[0] = 1.0f;
+    }
+    else
+    {
+        weights[0] = 1.0f - t;
+        weights[1] = t;
+    }
+    return true;
+}
+
+// Distance between two convex shapes (GJK), or that they overlap. An empty polygon overlaps nothing and is
+// infinitely far from everything.
+template<typename ShapeA, typename ShapeB>
+GjkResult Gjk(const ShapeA& a, const ShapeB& b)
+{
+    GjkResult result{};
+    if (IsEmptyShape(a) || IsEmptyShape(b))
+    {
+        result.distance = FLT_MAX;
+        return result;
+    }
+
+    MinkowskiDifference<ShapeA, ShapeB> difference{ a, b, 0, 0 };
+    result.simplex[0] = difference.Support({ 1.0f, 0.0f });
+    result.simplexCount = 1;
+
+    float weights[3] = { 1.0f, 0.0f, 0.0f };
+    Vector2 closest = result.simplex[0].point;
+    bool converged = false;
+    for (int iteration = 0; iteration < GJK_MAX_ITERATIONS && !converged; iteration++)
+    {
+        if (!ReduceSimplex(result.simplex, result.simplexCount, weights, closest))
+        {
+            result.overlapping = true;
+            return result;
+        }
+
+        const float closestSqr = LengthSqr(closest);
+        if (closestSqr < CONVEX_TOLERANCE * CONVEX_TOLERANCE)
+        {
+            result.overlapping = true;
+            return result;
+        }
+
+        // Done when no support point gets meaningfully closer, rounding can hide a repeat from that test
+        const MinkowskiPoint w = difference.Support(Negate(closest));
+        bool repeated = closestSqr - Dot(closest, w.point) <= CONVEX_TOLERANCE * closestSqr;
+        for (int i = 0; i < result.simplexCount; i++)
+            repeated = repeated || (w.point.x == result.simplex[i].point.x && w.point.y == result.simplex[i].point.y);
+        converged = repeated;
+        if (!converged) result.simplex[result.simplexCount++] = w;
+    }
+
+    // Out of iterations, the last support point still needs its weight
+    if (!converged && !ReduceSimplex(result.simplex, result.simplexCount, weights, closest))
+    {
+        result.overlapping = true;
+        return result;
+    }
+
+    result.distance = Length(closest);
+    for (int i = 0; i < result.simplexCount; i++)
+    {
+        result.pointA = result.pointA + result.simplex[i].a * weights[i];
+        result.pointB = result.pointB + result.simplex[i].b * weights[i];
+    }
+    return result;
+}
+
+// Penetration of overlapping shapes from the final GJK simplex (EPA). normal points from a towards b, moving b
+// by normal * depth separates them.
+template<typename ShapeA, typename ShapeB>
+bool Epa(const ShapeA& a, const ShapeB& b, const GjkResult& gjk, Vector2& normal, float& depth)
+{
+    if (!gjk.overlapping) return false;
+
+    MinkowskiDifference<ShapeA, ShapeB> difference{ a, b, 0, 0 };
+    Vector2 polytope[EPA_MAX_VERTICES];
+    int count = 0;
+    for (int i = 0; i < gjk.simplexCount; i++)
+        polytope[count++] = gjk.simplex[i].point;
+
+    // Grow a point or segment into a triangle around the origin
+    if (count == 1)
+    {
+        polytope[count++] = difference.Support(Negate(polytope[0])).point;
+        if (LengthSqr(polytope[1] - polytope[0]) == 0.0f) polytope[1] = difference.Support({ 1.0f, 0.0f }).point;
+    }
+    if (count == 2)
+    {
+        const Vector2 edge = polytope[1] - polytope[0];
+        polytope[count++] = difference.Support({ -edge.y, edge.x }).point;
+        if (fabsf(Cross(edge, polytope[2] - polytope[0])) <= CONVEX_TOLERANCE * LengthSqr(edge))
+            polytope[2] = difference.Support({ edge.y, -edge.x }).point;
+    }
+    if (Cross(polytope[1] - polytope[0], polytope[2] - polytope[0]) < 0.0f) std::swap(polytope[1], polytope[2]);
+
+    for (int iteration = 0; iteration < EPA_MAX_ITERATIONS; iteration++)
+    {
+        // Edge nearest the origin
+        int nearest = 0;
+        float nearestDistance = FLT_MAX;
+        Vector2 nearestNormal{};
+        for (int i = 0; i < count; i++)
+        {
+            const Vector2 edge = polytope[(i + 1) % count] - polytope[i];
+            if (LengthSqr(edge) == 0.0f) continue;
+
+            const Vector2 outward = Normalize(Vector2{ edge.y, -edge.x });
+            const float distance = Dot(outward, polytope[i]);
+            if (distance < nearestDistance)
+            {
+                nearestDistance = distance;
+                nearestNormal = outward;
+                nearest = i;
+            }
+        }
+
+        const Vector2 support = difference.Support(nearestNormal).point;
+        const float supportDistance = Dot(support, nearestNormal);
+        normal = nearestNormal;
+        depth = std::max(nearestDistance, 0.0f);
+        if (supportDistance - nearestDistance <= CONVEX_TOLERANCE * std::max(1.0f, supportDistance) || count == EPA_MAX_VERTICES)
+            return true;
+
+        for (int i = count; i > nearest + 1; i--)
+            polytope[i] = polytope[i - 1];
+        polytope[nearest + 1] = support;
+        count++;
+    }
+    return true;
+}
+
+// Overlap tests through GJK, any pairing of ConvexPolygon, Rectangle, Circle and OrientedBox works
+template<typename ShapeA, typename ShapeB>
+bool CheckCollisionConvex(const ShapeA& a, const ShapeB& b)
+{
+    return Gjk(a, b).overlapping;
+}
+
+// Distance between shapes, 0 when they overlap. pointA and pointB get the closest points when apart.
+template<typename ShapeA, typename ShapeB>
+float GetConvexDistance(const ShapeA& a, const ShapeB& b, Vector2* pointA = nullptr, Vector2* pointB = nullptr)
+{
+    const GjkResult result = Gjk(a, b);
+    if (pointA != nullptr) *pointA = result.pointA;
+    if (pointB != nullptr) *pointB = result.pointB;
+    return result.distance;
+}
+
+// Minimum translation to separate overlapping shapes, normal points from a towards b
+template<typename ShapeA, typename ShapeB>
+bool GetConvexPenetration(const ShapeA& a, const ShapeB& b, Vector2& normal, float& depth)
+{
+    return Epa(a, b, Gjk(a, b), normal, depth);
+}
+
+bool CheckCollisionPointConvex(Vector2 point, const ConvexPolygon& polygon)
+{
+    for (size_t i = 0; i < polygon.vertices.size(); i++)
+    {
+        if (Dot(polygon.normals[i], point - polygon.vertices[i]) > 0.0f) return false;
+    }
+    return !polygon.vertices.empty();
+}
+
+// Clips the segment against each edge's half plane (Cyrus-Beck). poi is where the segment enters the polygon,
+// lineStart if it starts inside.
+bool CheckCollisionLineConvex(Vector2 lineStart, Vector2 lineEnd, const ConvexPolygon& polygon, Vector2& poi)
+{
+    if (polygon.vertices.size() < 3) return false;
+
+    const Vector2 delta = lineEnd - lineStart;
+    float enter = 0.0f, exit = 1.0f;
+    for (size_t i = 0; i < polygon.vertices.size(); i++)
+    {
+        const float distance = Dot(polygon.normals[i], lineStart - polygon.vertices[i]);
+        const float rate = Dot(polygon.normals[i], delta);
+        if (rate == 0.0f)
+        {
+            if (distance > 0.0f) return false;
+            continue;
+        }
+
+        const float t = -distance / rate;
+        if (rate < 0.0f)
+            enter = std::max(enter, t);
+        else
+            exit = std::min(exit, t);
+        if (enter > exit) return false;
+    }
+
+    poi = lineStart + delta * enter;
+    return true;
+}
+
+bool CheckCollisionLineConvex(Vector2 lineStart, Vector2 lineEnd, const ConvexPolygon& polygon)
+{
+    Vector2 poi;
+    return CheckCollisionLineConvex(lineStart, lineEnd, polygon, poi);
+}
+
+// Nearest hit along the segment, like the Rectangle version in Collision.h
+bool NearestIntersection(Vector2 lineStart, Vector2 lineEnd, const std::vector<ConvexPolygon>& obstacles, Vector2& poi)
+{
+    float nearest = FLT_MAX;
+    for (const ConvexPolygon& obstacle : obstacles)
+    {
+        Vector2 hit;
+        if (!CheckCollisionLineRec(lineStart, lineEnd, obstacle.bounds) && !CheckCollisionPointRec(lineStart, obstacle.bounds))
+            continue;
+        if (!CheckCollisionLineConvex(lineStart, lineEnd, obstacle, hit)) continue;
+
+        const float distance = DistanceSqr(lineStart, hit);
+        if (distance < nearest)
+        {
+            nearest = distance;
+            poi = hit;
+        }
+    }
+    return nearest < FLT_MAX;
+}
+
+void DrawConvexPolygon(const ConvexPolygon& polygon, Color color)
+{
+    for (size_t i = 1; i + 1 < polygon.vertices.size(); i++)
+        DrawTriangle(polygon.vertices[0], polygon.vertices[i + 1], polygon.vertices[i], color);
+}
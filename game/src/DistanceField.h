@@ -0,0 +1,221 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "ObstacleGrid.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// World units between distance samples
+#define DISTANCE_FIELD_CELL_SIZE 8.0f
+
+// Distances are clamped to this, which bounds how far an obstacle edit can reach
+#define DISTANCE_FIELD_MAX_DISTANCE 128.0f
+
+#define DISTANCE_FIELD_INFINITY 1e20f
+
+// Exact 1D squared distance transform (Felzenszwalb and Huttenlocher), the lower envelope of parabolas rooted
+// at each sample of f. v and z are scratch of n and n + 1 entries.
+void DistanceTransform1D(const float* f, int n, float* d, int* v, float* z)
+{
+    int k = 0;
+    v[0] = 0;
+    z[0] = -DISTANCE_FIELD_INFINITY;
+    z[1] = DISTANCE_FIELD_INFINITY;
+    for (int q = 1; q < n; q++)
+    {
+        float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * (q - v[k]));
+        while (s <= z[k])
+        {
+            k--;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = DISTANCE_FIELD_INFINITY;
+    }
+
+    k = 0;
+    for (int q = 0; q < n; q++)
+    {
+        while (z[k + 1] < q) k++;
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+// Squared distance (in samples) from every sample to the nearest seed, where seeds hold 0 and the rest
+// DISTANCE_FIELD_INFINITY. Columns then rows, each pass split across the pool.
+void DistanceTransform2D(std::vector<float>& grid, int width, int height, ThreadPool& pool)
+{
+    ParallelFor(pool, width, 8, [&](size_t begin, size_t end)
+    {
+        std::vector<float> f(height), d(height), z(height + 1);
+        std::vector<int> v(height);
+        for (size_t x = begin; x < end; x++)
+        {
+            for (int y = 0; y < height; y++)
+                f[y] = grid[y * width + x];
+            DistanceTransform1D(f.data(), height, d.data(), v.data(), z.data());
+            for (int y = 0; y < height; y++)
+                grid[y * width + x] = d[y];
+        }
+    });
+
+    ParallelFor(pool, height, 8, [&](size_t begin, size_t end)
+    {
+        std::vector<float> d(width), z(width + 1);
+        std::vector<int> v(width);
+        for (size_t y = begin; y < end; y++)
+        {
+            float* row = &grid[y * width];
+            DistanceTransform1D(row, width, d.data(), v.data(), z.data());
+            std::copy(d.begin(), d.end(), row);
+        }
+    });
+}
+
+// Signed distance to the nearest obstacle sampled on a regular grid, negative inside obstacles. Distances are
+// clamped to DISTANCE_FIELD_MAX_DISTANCE so an edit only changes samples within that distance of it.
+class DistanceField
+{
+public:
+    void Build(Rectangle bounds, const ObstacleGrid& obstacles, float cellSize = DISTANCE_FIELD_CELL_SIZE,
+        ThreadPool& pool = DefaultThreadPool())
+    {
+        mBounds = bounds;
+        mCellSize = cellSize;
+        mInvCellSize = 1.0f / cellSize;
+        mWidth = (int)ceilf(bounds.width * mInvCellSize) + 1;
+        mHeight = (int)ceilf(bounds.height * mInvCellSize) + 1;
+        mDistances.assign((size_t)mWidth * mHeight, DISTANCE_FIELD_MAX_DISTANCE);
+        Update(bounds, obstacles, pool);
+    }
+
+    // Recomputes every sample whose distance an edit to obstacles inside region could have changed
+    void Update(Rectangle region, const ObstacleGrid& obstacles, ThreadPool& pool = DefaultThreadPool())
+    {
+        if (mDistances.empty()) return;
+
+        // Samples to rewrite, then the wider window whose obstacles can reach them
+        const int reach = (int)ceilf(DISTANCE_FIELD_MAX_DISTANCE * mInvCellSize) + 1;
+        int x0, y0, x1, y1;
+        SampleRange(region, reach, x0, y0, x1, y1);
+        if (x0 > x1 || y0 > y1) return;
+
+        const int wx0 = std::max(x0 - reach, 0), wy0 = std::max(y0 - reach, 0);
+        const int wx1 = std::min(x1 + reach, mWidth - 1), wy1 = std::min(y1 + reach, mHeight - 1);
+        const int width = wx1 - wx0 + 1, height = wy1 - wy0 + 1;
+
+        // Samples inside each obstacle, or the nearest one for obstacles thinner than a cell so none go missing
+        std::vector<unsigned char> inside((size_t)width * height, 0);
+        std::vector<int> ids;
+        obstacles.QueryRect({ mBounds.x + wx0 * mCellSize, mBounds.y + wy0 * mCellSize,
+            (width - 1) * mCellSize, (height - 1) * mCellSize }, ids);
+        for (int id : ids)
+        {
+            const Rectangle& r = obstacles.Get(id);
+            int rx0, ry0, rx1, ry1;
+            CoveredRange(r.x, r.width, mBounds.x, rx0, rx1);
+            CoveredRange(r.y, r.height, mBounds.y, ry0, ry1);
+            rx0 = std::max(rx0, wx0);
+            ry0 = std::max(ry0, wy0);
+            rx1 = std::min(rx1, wx1);
+            ry1 = std::min(ry1, wy1);
+            for (int y = ry0; y <= ry1; y++)
+            {
+                for (int x = rx0; x <= rx1; x++)
+                    inside[(y - wy0) * width + (x - wx0)] = 1;
+            }
+        }
+
+        // Distance to the nearest inside sample for outside samples and vice versa
+        std::vector<float> outside((size_t)width * height), interior((size_t)width * height);
+        for (size_t i = 0; i < inside.size(); i++)
+        {
+            outside[i] = inside[i] ? 0.0f : DISTANCE_FIELD_INFINITY;
+            interior[i] = inside[i] ? DISTANCE_FIELD_INFINITY : 0.0f;
+        }
+        DistanceTransform2D(outside, width, height, pool);
+        DistanceTransform2D(interior, width, height, pool);
+
+        // The surface lies between an inside sample and its outside neighbour, split the difference
+        const float half = mCellSize * 0.5f;
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                const size_t i = (size_t)(y - wy0) * width + (x - wx0);
+                const float distance = inside[i] ? half - sqrtf(interior[i]) * mCellSize : sqrtf(outside[i]) * mCellSize - half;
+                mDistances[(size_t)y * mWidth + x] = Clamp(distance, -DISTANCE_FIELD_MAX_DISTANCE, DISTANCE_FIELD_MAX_DISTANCE);
+            }
+        }
+    }
+
+    // Bilinear distance at position, positions outside the bounds take the nearest edge value. May overestimate
+    // the true distance by up to one cell.
+    float Sample(Vector2 position) const
+    {
+        if (mDistances.empty()) return DISTANCE_FIELD_MAX_DISTANCE;
+
+        const float fx = Clamp((position.x - mBounds.x) * mInvCellSize, 0.0f, (float)(mWidth - 1));
+        const float fy = Clamp((position.y - mBounds.y) * mInvCellSize, 0.0f, (float)(mHeight - 1));
+        const int x = std::min((int)fx, mWidth - 2 < 0 ? 0 : mWidth - 2);
+        const int y = std::min((int)fy, mHeight - 2 < 0 ? 0 : mHeight - 2);
+        const float tx = fx - x, ty = fy - y;
+
+        const float* row0 = &mDistances[(size_t)y * mWidth + x];
+        const float* row1 = mHeight > 1 ? row0 + mWidth : row0;
+        const int right = mWidth > 1 ? 1 : 0;
+        const float top = row0[0] + (row0[right] - row0[0]) * tx;
+        const float bottom = row1[0] + (row1[right] - row1[0]) * tx;
+        return top + (bottom - top) * ty;
+    }
+
+    // Direction of increasing distance, away from the nearest obstacle
+    Vector2 Gradient(Vector2 position) const
+    {
+        const float h = mCellSize * 0.5f;
+        const Vector2 gradient{ Sample({ position.x + h, position.y }) - Sample({ position.x - h, position.y }),
+            Sample({ position.x, position.y + h }) - Sample({ position.x, position.y - h }) };
+        return Normalize(gradient);
+    }
+
+    Rectangle Bounds() const
+    {
+        return mBounds;
+    }
+
+    float CellSize() const
+    {
+        return mCellSize;
+    }
+
+private:
+    // Samples along one axis inside [start, start + size], at least the nearest one
+    void CoveredRange(float start, float size, float origin, int& first, int& last) const
+    {
+        const float from = (start - origin) * mInvCellSize;
+        const float to = (start + size - origin) * mInvCellSize;
+        first = (int)ceilf(from);
+        last = (int)floorf(to);
+        if (first > last) first = last = (int)roundf((from + to) * 0.5f);
+    }
+
+    // Samples covering region grown by padding samples, clipped to the field
+    void SampleRange(Rectangle region, int padding, int& x0, int& y0, int& x1, int& y1) const
+    {
+        x0 = std::max((int)floorf((region.x - mBounds.x) * mInvCellSize) - padding, 0);
+        y0 = std::max((int)floorf((region.y - mBounds.y) * mInvCellSize) - padding, 0);
+        x1 = std::min((int)ceilf((region.x + region.width - mBounds.x) * mInvCellSize) + padding, mWidth - 1);
+        y1 = std::min((int)ceilf((region.y + region.height - mBounds.y) * mInvCellSize) + padding, mHeight - 1);
+    }
+
+    Rectangle mBounds{};
+    float mCellSize = DISTANCE_FIELD_CELL_SIZE;
+    float mInvCellSize = 1.0f / DISTANCE_FIELD_CELL_SIZE;
+    int mWidth = 0;
+    int mHeight = 0;
+    std::vector<float> mDistances;  // row major, sample (x, y) sits at bounds + (x, y) * cellSize
+};
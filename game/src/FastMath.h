@@ -0,0 +1,279 @@
+#pragma once
+#include "Math.h"
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Cheaper stand-ins for sinf/cosf, sqrtf and atan2f in loops that run per agent per frame. The bounds next to
+// each function are the largest errors seen sweeping its whole domain against the precise version, the array
+// forms work on four floats at a time with SSE and stay within the same bounds.
+
+// 1.5 * 2^23, adding and taking it away again rounds a float below 2^22 to the nearest integer
+#define FAST_ROUND 12582912.0f
+
+#define FAST_TWO_OVER_PI 0.636619772f
+
+// pi / 2 in three parts, the first two have few enough bits that multiples of them are exact
+#define FAST_HALF_PI_A 1.5703125f
+#define FAST_HALF_PI_B 4.83751296997070312e-4f
+#define FAST_HALF_PI_C 7.54978995489188216e-8f
+
+// Minimax sine and cosine on [-pi/4, pi/4]
+#define FAST_SIN_1 -1.6666654611e-1f
+#define FAST_SIN_2 8.3321608736e-3f
+#define FAST_SIN_3 -1.9515295891e-4f
+#define FAST_COS_1 4.166664568298827e-2f
+#define FAST_COS_2 -1.388731625493765e-3f
+#define FAST_COS_3 2.443315711809948e-5f
+
+// Minimax atan on [0, 1], as x * P(x^2)
+#define FAST_ATAN_0 0.999996112f
+#define FAST_ATAN_1 -0.333173682f
+#define FAST_ATAN_2 0.198078158f
+#define FAST_ATAN_3 -0.132333414f
+#define FAST_ATAN_4 0.079623643f
+#define FAST_ATAN_5 -0.0336041866f
+#define FAST_ATAN_6 0.00681178033f
+
+// Sine and cosine of the same angle for the price of one. Within 1e-7 for |angle| < 8192 and 5e-7 below 32768,
+// past that the error grows with the angle as a float angle loses its fraction.
+RMCONSTEXPR void SinCosFast(float angle, float& sine, float& cosine)
+{
+    // Nearest quarter turn and what's left of the angle after it
+    const float quarters = (angle * FAST_TWO_OVER_PI + FAST_ROUND) - FAST_ROUND;
+    const int quadrant = (int)quarters & 3;
+    const float r = ((angle - quarters * FAST_HALF_PI_A) - quarters * FAST_HALF_PI_B) - quarters * FAST_HALF_PI_C;
+    const float r2 = r * r;
+
+    const float s = ((FAST_SIN_3 * r2 + FAST_SIN_2) * r2 + FAST_SIN_1) * r2 * r + r;
+    const float c = ((FAST_COS_3 * r2 + FAST_COS_2) * r2 + FAST_COS_1) * r2 * r2 - 0.5f * r2 + 1.0f;
+    switch (quadrant)
+    {
+    case 0: sine = s; cosine = c; break;
+    case 1: sine = c; cosine = -s; break;
+    case 2: sine = -s; cosine = -c; break;
+    default: sine = -c; cosine = s; break;
+    }
+}
+
+// Direction with SinCosFast, same bounds. Both work in constant expressions, for rotation tables built at
+// compile time.
+RMCONSTEXPR Vector2 DirectionFast(float angle)
+{
+    Vector2 result = { 0 };
+    SinCosFast(angle, result.y, result.x);
+    return result;
+}
+
+// 1 / sqrtf(x) for x >= FLT_MIN, within 3e-7 relative error with SSE and 5e-6 without. rsqrtss is 12 bits and
+// one Newton step doubles that, without SSE the first guess is the bit trick and takes two steps.
+float InvSqrtFast(float x)
+{
+    const float half = 0.5f * x;
+#if defined(MATH_SSE)
+    float guess = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5f375a86u - (bits >> 1);
+    float guess;
+    memcpy(&guess, &bits, sizeof(guess));
+    guess = guess * (1.5f - half * guess * guess);
+#endif
+    return guess * (1.5f - half * guess * guess);
+}
+
+// atan2f within 6e-7 radians, zero for (0, 0) and signed zeros and quadrants the same as atan2f.
+// Infinite and NaN arguments aren't handled.
+float Atan2Fast(float y, float x)
+{
+    const float ax = fabsf(x);
+    const float ay = fabsf(y);
+    const float hi = ax > ay ? ax : ay;
+    const float lo = ax > ay ? ay : ax;
+    const float t = hi > 0.0f ? lo / hi : 0.0f;
+    const float t2 = t * t;
+
+    float result = ((((((FAST_ATAN_6 * t2 + FAST_ATAN_5) * t2 + FAST_ATAN_4) * t2 + FAST_ATAN_3) * t2 +
+        FAST_ATAN_2) * t2 + FAST_ATAN_1) * t2 + FAST_ATAN_0) * t;
+    if (ay > ax) result = PI * 0.5f - result;
+    if (std::signbit(x)) result = PI - result;
+    return std::signbit(y) ? -result : result;
+}
+
+// Angle with Atan2Fast, same bound
+float AngleFast(Vector2 v1, Vector2 v2)
+{
+    return Atan2Fast(v2.y - v1.y, v2.x - v1.x);
+}
+
+#if defined(MATH_SSE)
+// Four lane versions of the above, the same sums in the same order
+
+__m128 SelectSimd(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+void SinCosSimd(__m128 angle, __m128& sine, __m128& cosine)
+{
+    const __m128 round = _mm_set1_ps(FAST_ROUND);
+    const __m128 quarters = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(angle, _mm_set1_ps(FAST_TWO_OVER_PI)), round), round);
+    const __m128i quadrant = _mm_cvttps_epi32(quarters);
+    __m128 r = _mm_sub_ps(angle, _mm_mul_ps(quarters, _mm_set1_ps(FAST_HALF_PI_A)));
+    r = _mm_sub_ps(r, _mm_mul_ps(quarters, _mm_set1_ps(FAST_HALF_PI_B)));
+    r = _mm_sub_ps(r, _mm_mul_ps(quarters, _mm_set1_ps(FAST_HALF_PI_C)));
+    const __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(FAST_SIN_3), r2), _mm_set1_ps(FAST_SIN_2));
+    s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(FAST_SIN_1));
+    s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+    __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(FAST_COS_3), r2), _mm_set1_ps(FAST_COS_2));
+    c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(FAST_COS_1));
+    c = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, r2), r2), _mm_mul_ps(_mm_set1_ps(0.5f), r2));
+    c = _mm_add_ps(c, _mm_set1_ps(1.0f));
+
+    // Odd quadrants swap sine and cosine, quadrants 2 and 3 negate the sine and 1 and 2 the cosine
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+    const __m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(quadrant, 1), 31));
+    const __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_srli_epi32(_mm_add_epi32(quadrant, one), 1), 31));
+    sine = _mm_xor_ps(SelectSimd(swap, c, s), sineSign);
+    cosine = _mm_xor_ps(SelectSimd(swap, s, c), cosineSign);
+}
+
+__m128 InvSqrtSimd(__m128 x)
+{
+    const __m128 half = _mm_mul_ps(_mm_set1_ps(0.5f), x);
+    const __m128 guess = _mm_rsqrt_ps(x);
+    return _mm_mul_ps(guess, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(half, guess), guess)));
+}
+
+__m128 Atan2Simd(__m128 y, __m128 x)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 ax = _mm_andnot_ps(sign, x);
+    const __m128 ay = _mm_andnot_ps(sign, y);
+    const __m128 hi = _mm_max_ps(ax, ay);
+    const __m128 lo = _mm_min_ps(ax, ay);
+    const __m128 t = _mm_and_ps(_mm_cmpgt_ps(hi, _mm_setzero_ps()), _mm_div_ps(lo, hi));
+    const __m128 t2 = _mm_mul_ps(t, t);
+
+    __m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(FAST_ATAN_6), t2), _mm_set1_ps(FAST_ATAN_5));
+    result = _mm_add_ps(_mm_mul_ps(result, t2), _mm_set1_ps(FAST_ATAN_4));
+    result = _mm_add_ps(_mm_mul_ps(result, t2), _mm_set1_ps(FAST_ATAN_3));
+    result = _mm_add_ps(_mm_mul_ps(result, t2), _mm_set1_ps(FAST_ATAN_2));
+    result = _mm_add_ps(_mm_mul_ps(result, t2), _mm_set1_ps(FAST_ATAN_1));
+    result = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(result, t2), _mm_set1_ps(FAST_ATAN_0)), t);
+    result = SelectSimd(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(PI * 0.5f), result), result);
+    const __m128 negativeX = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+    result = SelectSimd(negativeX, _mm_sub_ps(_mm_set1_ps(PI), result), result);
+    return _mm_xor_ps(result, _mm_and_ps(sign, y));
+}
+#endif
+
+// Array forms, out may be the same array as in
+
+void SinCosFast(const float* angles, float* sines, float* cosines, size_t count)
+{
+    size_t i = 0;
+#if defined(MATH_SSE)
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 sine, cosine;
+        SinCosSimd(_mm_loadu_ps(angles + i), sine, cosine);
+        _mm_storeu_ps(sines + i, sine);
+        _mm_storeu_ps(cosines + i, cosine);
+    }
+#endif
+    for (; i < count; i++)
+        SinCosFast(angles[i], sines[i], cosines[i]);
+}
+
+void DirectionFast(const float* angles, Vector2* directions, size_t count)
+{
+    size_t i = 0;
+#if defined(MATH_SSE)
+    float* out = (float*)directions;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 sine, cosine;
+        SinCosSimd(_mm_loadu_ps(angles + i), sine, cosine);
+        _mm_storeu_ps(out + i * 2, _mm_unpacklo_ps(cosine, sine));
+        _mm_storeu_ps(out + i * 2 + 4, _mm_unpackhi_ps(cosine, sine));
+    }
+#endif
+    for (; i < count; i++)
+        directions[i] = DirectionFast(angles[i]);
+}
+
+void InvSqrtFast(const float* in, float* out, size_t count)
+{
+    size_t i = 0;
+#if defined(MATH_SSE)
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, InvSqrtSimd(_mm_loadu_ps(in + i)));
+#endif
+    for (; i < count; i++)
+        out[i] = InvSqrtFast(in[i]);
+}
+
+// Normalize with InvSqrtSimd, same relative bound as InvSqrtFast. Vectors shorter than 1e-19 come back zero.
+// There's no single vector form, one at a time it's no faster than Normalize.
+void NormalizeFast(const Vector2* in, Vector2* out, size_t count)
+{
+    size_t i = 0;
+#if defined(MATH_SSE)
+    // Two vectors per step, each length squared lands in both of its lanes
+    const float* from = (const float*)in;
+    float* to = (float*)out;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128 v = _mm_loadu_ps(from + i * 2);
+        const __m128 squares = _mm_mul_ps(v, v);
+        const __m128 lengthSqr = _mm_add_ps(squares, MATH_SHUFFLE(squares, squares, 1, 0, 3, 2));
+        const __m128 valid = _mm_cmpge_ps(lengthSqr, _mm_set1_ps(FLT_MIN));
+        _mm_storeu_ps(to + i * 2, _mm_and_ps(valid, _mm_mul_ps(v, InvSqrtSimd(lengthSqr))));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float lengthSqr = in[i].x * in[i].x + in[i].y * in[i].y;
+        const float inverse = lengthSqr >= FLT_MIN ? 1.0f / sqrtf(lengthSqr) : 0.0f;
+        out[i] = { in[i].x * inverse, in[i].y * inverse };
+    }
+}
+
+void Atan2Fast(const float* y, const float* x, float* out, size_t count)
+{
+    size_t i = 0;
+#if defined(MATH_SSE)
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, Atan2Simd(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+#endif
+    for (; i < count; i++)
+        out[i] = Atan2Fast(y[i], x[i]);
+}
+
+// Angle from origin to each point
+void AngleFast(Vector2 origin, const Vector2* points, float* angles, size_t count)
+{
+    size_t i = 0;
+#if defined(MATH_SSE)
+    const float* from = (const float*)points;
+    const __m128 originX = _mm_set1_ps(origin.x);
+    const __m128 originY = _mm_set1_ps(origin.y);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 a = _mm_loadu_ps(from + i * 2);
+        const __m128 b = _mm_loadu_ps(from + i * 2 + 4);
+        const __m128 x = _mm_sub_ps(MATH_SHUFFLE(a, b, 0, 2, 0, 2), originX);
+        const __m128 y = _mm_sub_ps(MATH_SHUFFLE(a, b, 1, 3, 1, 3), originY);
+        _mm_storeu_ps(angles + i, Atan2Simd(y, x));
+    }
+#endif
+    for (; i < count; i++)
+        angles[i] = AngleFast(origin, points[i]);
+}
@@ -0,0 +1,289 @@
+// Kept out of the header so platform headers never meet raylib.h
+#include "FileWatcher.h"
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+struct FileWatcher
+{
+    std::string root;
+    FileChangedCallback onChanged;
+    std::atomic<bool> stopping{ false };
+    std::thread thread;
+    HANDLE directory = INVALID_HANDLE_VALUE;
+};
+
+static bool OpenWatcher(FileWatcher* watcher)
+{
+    watcher->directory = CreateFileA(watcher->root.c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    return watcher->directory != INVALID_HANDLE_VALUE;
+}
+
+static void CloseWatcher(FileWatcher* watcher)
+{
+    if (watcher->directory != INVALID_HANDLE_VALUE) CloseHandle(watcher->directory);
+}
+
+static void RunWatcher(FileWatcher* watcher)
+{
+    alignas(DWORD) char buffer[16384];
+    OVERLAPPED overlapped{};
+    overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    std::set<std::string> pending;
+    bool issued = false;
+
+    while (!watcher->stopping)
+    {
+        if (!issued)
+        {
+            issued = ReadDirectoryChangesW(watcher->directory, buffer, sizeof(buffer), TRUE,
+                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, &overlapped, nullptr) != 0;
+        }
+
+        if (issued && WaitForSingleObject(overlapped.hEvent, FILE_WATCHER_SETTLE_MS) == WAIT_OBJECT_0)
+        {
+            DWORD bytes = 0;
+            GetOverlappedResult(watcher->directory, &overlapped, &bytes, FALSE);
+            ResetEvent(overlapped.hEvent);
+            issued = false;
+
+            // Zero bytes means the buffer overflowed and the batch was dropped
+            for (DWORD offset = 0; bytes > 0;)
+            {
+                const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)(buffer + offset);
+                if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED ||
+                    info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+                {
+                    int wideLength = (int)(info->FileNameLength / sizeof(WCHAR));
+                    int length = WideCharToMultiByte(CP_UTF8, 0, info->FileName, wideLength, nullptr, 0, nullptr, nullptr);
+                    std::string name(length, '\0');
+                    WideCharToMultiByte(CP_UTF8, 0, info->FileName, wideLength, &name[0], length, nullptr, nullptr);
+                    for (char& c : name)
+                        if (c == '\\') c = '/';
+                    pending.insert(watcher->root + "/" + name);
+                }
+
+                if (info->NextEntryOffset == 0) break;
+                offset += info->NextEntryOffset;
+            }
+            continue;
+        }
+
+        if (!issued) Sleep(FILE_WATCHER_SETTLE_MS);
+        for (const std::string& fileName : pending)
+            watcher->onChanged(fileName);
+        pending.clear();
+    }
+
+    if (issued)
+    {
+        DWORD bytes = 0;
+        CancelIo(watcher->directory);
+        GetOverlappedResult(watcher->directory, &overlapped, &bytes, TRUE);
+    }
+    CloseHandle(overlapped.hEvent);
+}
+
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <map>
+
+// Visits every entry below directory, depth first
+template<typename Visitor>
+static void ScanDirectory(const std::string& directory, Visitor visit)
+{
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) return;
+
+    while (dirent* entry = readdir(dir))
+    {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") continue;
+
+        std::string path = directory + "/" + name;
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) continue;
+
+        visit(path, info);
+        if (S_ISDIR(info.st_mode)) ScanDirectory(path, visit);
+    }
+    closedir(dir);
+}
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unordered_map>
+
+struct FileWatcher
+{
+    std::string root;
+    FileChangedCallback onChanged;
+    std::atomic<bool> stopping{ false };
+    std::thread thread;
+    int descriptor = -1;
+    std::unordered_map<int, std::string> directories;
+};
+
+// inotify isn't recursive, every directory gets its own watch
+static void AddWatches(FileWatcher* watcher, const std::string& directory)
+{
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+    int watch = inotify_add_watch(watcher->descriptor, directory.c_str(), mask);
+    if (watch >= 0) watcher->directories[watch] = directory;
+
+    ScanDirectory(directory, [watcher, mask](const std::string& path, const struct stat& info)
+    {
+        if (!S_ISDIR(info.st_mode)) return;
+        int child = inotify_add_watch(watcher->descriptor, path.c_str(), mask);
+        if (child >= 0) watcher->directories[child] = path;
+    });
+}
+
+static bool OpenWatcher(FileWatcher* watcher)
+{
+    watcher->descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher->descriptor < 0) return false;
+
+    AddWatches(watcher, watcher->root);
+    return !watcher->directories.empty();
+}
+
+static void CloseWatcher(FileWatcher* watcher)
+{
+    if (watcher->descriptor >= 0) close(watcher->descriptor);
+}
+
+static void RunWatcher(FileWatcher* watcher)
+{
+    alignas(inotify_event) char buffer[16384];
+    std::set<std::string> pending;
+
+    while (!watcher->stopping)
+    {
+        pollfd request{ watcher->descriptor, POLLIN, 0 };
+        if (poll(&request, 1, FILE_WATCHER_SETTLE_MS) > 0)
+        {
+            ssize_t bytes = read(watcher->descriptor, buffer, sizeof(buffer));
+            for (ssize_t offset = 0; offset < bytes;)
+            {
+                const inotify_event* event = (const inotify_event*)(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                auto directory = watcher->directories.find(event->wd);
+                if (directory == watcher->directories.end() || event->len == 0) continue;
+
+                std::string path = directory->second + "/" + event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) AddWatches(watcher, path);
+                }
+                else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    pending.insert(path);
+                }
+            }
+            continue;
+        }
+
+        for (const std::string& fileName : pending)
+            watcher->onChanged(fileName);
+        pending.clear();
+    }
+}
+
+#else
+
+struct FileWatcher
+{
+    std::string root;
+    FileChangedCallback onChanged;
+    std::atomic<bool> stopping{ false };
+    std::thread thread;
+    std::map<std::string, time_t> modTimes;
+};
+
+static void SnapshotDirectory(const std::string& root, std::map<std::string, time_t>& modTimes)
+{
+    modTimes.clear();
+    ScanDirectory(root, [&modTimes](const std::string& path, const struct stat& info)
+    {
+        if (S_ISREG(info.st_mode)) modTimes[path] = info.st_mtime;
+    });
+}
+
+static bool OpenWatcher(FileWatcher* watcher)
+{
+    struct stat info;
+    if (stat(watcher->root.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) return false;
+
+    SnapshotDirectory(watcher->root, watcher->modTimes);
+    return true;
+}
+
+static void CloseWatcher(FileWatcher* watcher)
+{
+}
+
+static void RunWatcher(FileWatcher* watcher)
+{
+    std::map<std::string, time_t> current;
+    while (!watcher->stopping)
+    {
+        for (int waited = 0; waited < FILE_WATCHER_POLL_MS && !watcher->stopping; waited += FILE_WATCHER_SETTLE_MS)
+            std::this_thread::sleep_for(std::chrono::milliseconds(FILE_WATCHER_SETTLE_MS));
+
+        SnapshotDirectory(watcher->root, current);
+        for (const auto& file : current)
+        {
+            auto previous = watcher->modTimes.find(file.first);
+            if (previous == watcher->modTimes.end() || previous->second != file.second)
+                watcher->onChanged(file.first);
+        }
+        watcher->modTimes.swap(current);
+    }
+}
+
+#endif
+#endif
+
+FileWatcher* LoadFileWatcher(const char* directory, FileChangedCallback onChanged)
+{
+    FileWatcher* watcher = new FileWatcher;
+    watcher->root = directory;
+    for (char& c : watcher->root)
+        if (c == '\\') c = '/';
+    while (watcher->root.size() > 1 && watcher->root.back() == '/')
+        watcher->root.pop_back();
+    watcher->onChanged = onChanged;
+
+    if (!OpenWatcher(watcher))
+    {
+        CloseWatcher(watcher);
+        delete watcher;
+        return nullptr;
+    }
+
+    watcher->thread = std::thread(RunWatcher, watcher);
+    return watcher;
+}
+
+void UnloadFileWatcher(FileWatcher* watcher)
+{
+    if (watcher == nullptr) return;
+
+    watcher->stopping = true;
+    watcher->thread.join();
+    CloseWatcher(watcher);
+    delete watcher;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <functional>
+#include <string>
+
+// Changes are reported once a directory has been quiet this long, coalescing the bursts editors produce on save
+#define FILE_WATCHER_SETTLE_MS 100
+
+// Interval between scans on platforms without change notifications
+#define FILE_WATCHER_POLL_MS 500
+
+// Called on the watcher's thread with the path of a file that was written or moved into place
+typedef std::function<void(const std::string& fileName)> FileChangedCallback;
+
+struct FileWatcher;
+
+// Watches a directory tree on a background thread using inotify, ReadDirectoryChangesW or, elsewhere,
+// modification time polling. Reported paths are directory + "/" + relative path. Returns null on failure.
+FileWatcher* LoadFileWatcher(const char* directory, FileChangedCallback onChanged);
+
+// Stops the watcher thread, no callbacks run after this returns
+void UnloadFileWatcher(FileWatcher* watcher);
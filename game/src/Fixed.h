@@ -0,0 +1,458 @@
+#pragma once
+#include "Math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Scalar the lockstep code runs on: 0 for float, 16 for Q16.16 or 32 for Q32.32 fixed point. Fixed point only uses
+// integer operations so every compiler, flag and CPU gets the same bits, which lockstep replays rely on. Q16.16
+// tops out at 32768 and its squares at 181, so pixel coordinates want Q32.32. Only code written on Scalar
+// (ScalarRigidbody, the Scalar forms in Collision.h) follows it, PhysicsWorld and the demo stay on float.
+#ifndef FIXED_POINT_BITS
+#define FIXED_POINT_BITS 0
+#endif
+
+// Entries per quarter turn in the sine table. Interpolated sines are within 4e-7 of the true value.
+#define FIXED_SINE_TABLE_SIZE 1024
+
+// 2 / pi in Q32, angles are turned into quarter turns at this precision whatever their own
+#define FIXED_TWO_OVER_PI 2734261102ll
+
+// CORDIC steps for Atan2, each one adds a bit
+#define FIXED_ATAN_STEPS 30
+
+// Signed Q(64 - fractionBits).fractionBits product and quotient of two raw values. Both round towards zero and
+// saturate instead of overflowing, dividing by zero gives the largest value of the numerator's sign.
+int64_t FixedMultiply(int64_t a, int64_t b, int fractionBits)
+{
+    const bool negative = (a < 0) != (b < 0);
+    const uint64_t ua = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+    const uint64_t ub = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+
+    // 128 bit product from 32 bit halves
+    const uint64_t aLo = ua & 0xffffffffu, aHi = ua >> 32;
+    const uint64_t bLo = ub & 0xffffffffu, bHi = ub >> 32;
+    const uint64_t lolo = aLo * bLo, lohi = aLo * bHi, hilo = aHi * bLo, hihi = aHi * bHi;
+    const uint64_t middle = (lolo >> 32) + (lohi & 0xffffffffu) + (hilo & 0xffffffffu);
+    const uint64_t lo = (middle << 32) | (lolo & 0xffffffffu);
+    const uint64_t hi = hihi + (lohi >> 32) + (hilo >> 32) + (middle >> 32);
+
+    const uint64_t limit = (uint64_t)std::numeric_limits<int64_t>::max();
+    if (fractionBits < 64 && (hi >> fractionBits) != 0) return negative ? -(int64_t)limit : (int64_t)limit;
+    const uint64_t magnitude = fractionBits == 0 ? lo : (hi << (64 - fractionBits)) | (lo >> fractionBits);
+    if (magnitude > limit) return negative ? -(int64_t)limit : (int64_t)limit;
+    return negative ? -(int64_t)magnitude : (int64_t)magnitude;
+}
+
+int64_t FixedDivide(int64_t a, int64_t b, int fractionBits)
+{
+    const bool negative = (a < 0) != (b < 0);
+    const uint64_t ua = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+    const uint64_t ub = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+    const uint64_t limit = (uint64_t)std::numeric_limits<int64_t>::max();
+    if (ub == 0) return a < 0 ? -(int64_t)limit : (int64_t)limit;
+
+    // Long division of the 128 bit ua << fractionBits, a remainder that starts at or above ub would overflow
+    uint64_t remainder = fractionBits == 0 ? 0 : ua >> (64 - fractionBits);
+    uint64_t lo = ua << fractionBits;
+    if (remainder >= ub) return negative ? -(int64_t)limit : (int64_t)limit;
+
+    uint64_t quotient = 0;
+    for (int i = 0; i < 64; i++)
+    {
+        const bool carry = (remainder >> 63) != 0;
+        remainder = (remainder << 1) | (lo >> 63);
+        lo <<= 1;
+        quotient <<= 1;
+        if (carry || remainder >= ub)
+        {
+            remainder -= ub;
+            quotient |= 1;
+        }
+    }
+    if (quotient > limit) return negative ? -(int64_t)limit : (int64_t)limit;
+    return negative ? -(int64_t)quotient : (int64_t)quotient;
+}
+
+// Q32.32 multiply and divide need the 128 bit forms above, Q16.16 fits in 64 bits
+int32_t FixedMultiply(int32_t a, int32_t b, int fractionBits)
+{
+    const int64_t product = ((int64_t)a * b) / ((int64_t)1 << fractionBits);
+    return (int32_t)std::max<int64_t>(std::min<int64_t>(product, INT32_MAX), -INT32_MAX);
+}
+
+int32_t FixedDivide(int32_t a, int32_t b, int fractionBits)
+{
+    if (b == 0) return a < 0 ? -INT32_MAX : INT32_MAX;
+    const int64_t quotient = ((int64_t)a * ((int64_t)1 << fractionBits)) / b;
+    return (int32_t)std::max<int64_t>(std::min<int64_t>(quotient, INT32_MAX), -INT32_MAX);
+}
+
+// Sum and difference of two raw values, saturating to the same range as FixedMultiply instead of overflowing
+template<typename Raw>
+Raw FixedAdd(Raw a, Raw b)
+{
+    const Raw limit = std::numeric_limits<Raw>::max();
+    if (b > 0 && a > limit - b) return limit;
+    if (b < 0 && a < -limit - b) return -limit;
+    return a + b;
+}
+
+template<typename Raw>
+Raw FixedSubtract(Raw a, Raw b)
+{
+    const Raw limit = std::numeric_limits<Raw>::max();
+    if (b < 0 && a > limit + b) return limit;
+    if (b > 0 && a < -limit + b) return -limit;
+    return a - b;
+}
+
+// Signed fixed point number, raw / 2^FractionBits
+template<typename Raw, int FractionBits>
+struct Fixed
+{
+    Raw raw;
+
+    Fixed() : raw(0) {}
+    // Saturates like FixedMultiply when the value doesn't fit, an int times 2^32 always fits in 64 bits
+    explicit Fixed(int value)
+    {
+        static_assert(FractionBits <= 32, "int conversion computes in 64 bits");
+        const int64_t limit = std::numeric_limits<Raw>::max();
+        const int64_t scaled = (int64_t)value * ((int64_t)1 << FractionBits);
+        raw = (Raw)std::max(std::min(scaled, limit), -limit);
+    }
+
+    static Fixed FromRaw(Raw raw)
+    {
+        Fixed result;
+        result.raw = raw;
+        return result;
+    }
+
+    // Rounds to nearest. Fine for constants and loading, but a lockstep simulation mustn't take floats back in
+    // from anything computed with floats.
+    static Fixed FromDouble(double value)
+    {
+        return FromRaw((Raw)llround(value * (double)((Raw)1 << FractionBits)));
+    }
+
+    static Fixed FromFloat(float value)
+    {
+        return FromDouble((double)value);
+    }
+
+    float ToFloat() const
+    {
+        return (float)((double)raw / (double)((Raw)1 << FractionBits));
+    }
+
+    // Rounds towards negative infinity
+    int ToInt() const
+    {
+        return (int)(raw >> FractionBits);
+    }
+
+    static Fixed Max()
+    {
+        return FromRaw(std::numeric_limits<Raw>::max());
+    }
+
+    static Fixed Epsilon()
+    {
+        return FromRaw(1);
+    }
+
+    Fixed operator-() const { return FromRaw(FixedSubtract((Raw)0, raw)); }
+    Fixed operator+(Fixed other) const { return FromRaw(FixedAdd(raw, other.raw)); }
+    Fixed operator-(Fixed other) const { return FromRaw(FixedSubtract(raw, other.raw)); }
+    Fixed operator*(Fixed other) const { return FromRaw(FixedMultiply(raw, other.raw, FractionBits)); }
+    Fixed operator/(Fixed other) const { return FromRaw(FixedDivide(raw, other.raw, FractionBits)); }
+    Fixed& operator+=(Fixed other) { return *this = *this + other; }
+    Fixed& operator-=(Fixed other) { return *this = *this - other; }
+    Fixed& operator*=(Fixed other) { return *this = *this * other; }
+    Fixed& operator/=(Fixed other) { return *this = *this / other; }
+
+    bool operator==(Fixed other) const { return raw == other.raw; }
+    bool operator!=(Fixed other) const { return raw != other.raw; }
+    bool operator<(Fixed other) const { return raw < other.raw; }
+    bool operator<=(Fixed other) const { return raw <= other.raw; }
+    bool operator>(Fixed other) const { return raw > other.raw; }
+    bool operator>=(Fixed other) const { return raw >= other.raw; }
+};
+
+typedef Fixed<int32_t, 16> Fixed16;
+typedef Fixed<int64_t, 32> Fixed32;
+
+// Vector of fixed point components, the same functions as Vector2 in Math.h
+template<typename T>
+struct FixedVector2
+{
+    T x;
+    T y;
+};
+
+#if FIXED_POINT_BITS == 16
+typedef Fixed16 Scalar;
+typedef FixedVector2<Fixed16> ScalarVector2;
+#elif FIXED_POINT_BITS == 32
+typedef Fixed32 Scalar;
+typedef FixedVector2<Fixed32> ScalarVector2;
+#else
+typedef float Scalar;
+typedef Vector2 ScalarVector2;
+#endif
+
+//----------------------------------------------------------------------------------
+// Deterministic scalar functions, the float overloads forward to the C library
+//----------------------------------------------------------------------------------
+
+float Sqrt(float value) { return sqrtf(value); }
+float Sin(float angle) { return sinf(angle); }
+float Cos(float angle) { return cosf(angle); }
+float Atan2(float y, float x) { return atan2f(y, x); }
+float Abs(float value) { return fabsf(value); }
+
+template<typename Raw, int FractionBits>
+Fixed<Raw, FractionBits> Abs(Fixed<Raw, FractionBits> value)
+{
+    return value.raw < 0 ? -value : value;
+}
+
+template<typename Raw, int FractionBits>
+Fixed<Raw, FractionBits> Clamp(Fixed<Raw, FractionBits> value, Fixed<Raw, FractionBits> min, Fixed<Raw, FractionBits> max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+// Integer Newton iteration from above, exact to the last bit (rounded down). 0 for negative values.
+template<typename Raw, int FractionBits>
+Fixed<Raw, FractionBits> Sqrt(Fixed<Raw, FractionBits> value)
+{
+    typedef Fixed<Raw, FractionBits> T;
+    if (value.raw <= 0) return T();
+
+    // sqrt(raw * 2^FractionBits) in raw units, starting from a power of two above it
+    int bits = 0;
+    while (bits < (int)sizeof(Raw) * 8 - 1 && (value.raw >> bits) != 0) bits++;
+    const int shift = (bits + FractionBits) / 2 + 1;
+    T x = T::FromRaw(shift >= (int)sizeof(Raw) * 8 - 1 ? std::numeric_limits<Raw>::max() : (Raw)1 << shift);
+    for (;;)
+    {
+        const T next = T::FromRaw((Raw)((x.raw + (value / x).raw) / 2));
+        if (next >= x) return x;
+        x = next;
+    }
+}
+
+// Q30 value to a raw value with fractionBits, rounded to nearest
+int64_t FixedFromQ30(int64_t value, int fractionBits)
+{
+    if (fractionBits >= 30) return value * ((int64_t)1 << (fractionBits - 30));
+    const int64_t divisor = (int64_t)1 << (30 - fractionBits);
+    return (value + (value < 0 ? -divisor / 2 : divisor / 2)) / divisor;
+}
+
+// sin of [0, pi / 2] in Q30. Built at compile time from a Taylor series in integer arithmetic, so it's the same
+// table everywhere and costs nothing at startup.
+struct FixedSineTable
+{
+    int32_t values[FIXED_SINE_TABLE_SIZE + 1];
+
+    constexpr FixedSineTable() : values()
+    {
+        const int64_t one = (int64_t)1 << 30;
+        const int64_t halfPi = 1686629713;  // pi / 2 in Q30
+        for (int i = 0; i <= FIXED_SINE_TABLE_SIZE; i++)
+        {
+            // x - x^3 / 3! + x^5 / 5! ... to x^15, past Q30 precision over a quarter turn
+            const int64_t x = halfPi * i / FIXED_SINE_TABLE_SIZE;
+            const int64_t xx = x * x / one;
+            int64_t term = x, sum = x;
+            for (int n = 2; n <= 14; n += 2)
+            {
+                term = -term * xx / one / (n * (n + 1));
+                sum += term;
+            }
+            values[i] = (int32_t)std::min(sum, one);
+        }
+    }
+};
+
+// Sine of a Q32 number of quarter turns, any whole turns are ignored. Interpolates the table and mirrors it
+// into the quadrant.
+int64_t FixedSine(int64_t quarters)
+{
+    static constexpr FixedSineTable sines;
+    const int64_t position = quarters & 0x3ffffffffll;
+    const int quadrant = (int)(position >> 32);
+    int64_t along = position & 0xffffffffll;
+    if (quadrant & 1) along = 0x100000000ll - along;
+
+    const int64_t scaled = along * FIXED_SINE_TABLE_SIZE;
+    const int index = (int)(scaled >> 32);
+    const int64_t t = (scaled & 0xffffffffll) >> 2;   // Q30
+    const int64_t lo = sines.values[index];
+    const int64_t hi = sines.values[std::min(index + 1, FIXED_SINE_TABLE_SIZE)];
+    const int64_t sine = lo + (hi - lo) * t / ((int64_t)1 << 30);
+    return quadrant >= 2 ? -sine : sine;
+}
+
+template<typename Raw, int FractionBits>
+Fixed<Raw, FractionBits> Sin(Fixed<Raw, FractionBits> angle)
+{
+    const int64_t sine = FixedSine(FixedMultiply((int64_t)angle.raw, FIXED_TWO_OVER_PI, FractionBits));
+    return Fixed<Raw, FractionBits>::FromRaw((Raw)FixedFromQ30(sine, FractionBits));
+}
+
+// A quarter turn ahead of Sin
+template<typename Raw, int FractionBits>
+Fixed<Raw, FractionBits> Cos(Fixed<Raw, FractionBits> angle)
+{
+    const int64_t quarters = FixedMultiply((int64_t)angle.raw, FIXED_TWO_OVER_PI, FractionBits);
+    const int64_t sine = FixedSine(quarters + ((int64_t)1 << 32));
+    return Fixed<Raw, FractionBits>::FromRaw((Raw)FixedFromQ30(sine, FractionBits));
+}
+
+// Angle of (x, y) in (-pi, pi], CORDIC vectoring on the inputs scaled to 30 bits. Within 1e-9 radians.
+template<typename Raw, int FractionBits>
+Fixed<Raw, FractionBits> Atan2(Fixed<Raw, FractionBits> y, Fixed<Raw, FractionBits> x)
+{
+    typedef Fixed<Raw, FractionBits> T;
+
+    // atan(2^-i) in Q30
+    static const int64_t steps[FIXED_ATAN_STEPS] = { 843314857, 497837829, 263043837, 133525159, 67021687,
+        33543516, 16775851, 8388437, 4194283, 2097149, 1048576, 524288, 262144, 131072, 65536, 32768, 16384, 8192,
+        4096, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2 };
+    const int64_t pi = 3373259426ll;    // Q30
+
+    if (y.raw == 0) return x.raw < 0 ? T::FromRaw((Raw)FixedFromQ30(pi, FractionBits)) : T();
+
+    // Rotate into the right half plane first, CORDIC only converges within +-99 degrees
+    int64_t vx = x.raw, vy = y.raw, angle = 0;
+    if (vx < 0)
+    {
+        angle = vy >= 0 ? pi : -pi;
+        vx = -vx;
+        vy = -vy;
+    }
+
+    // Scale so the larger component sits just under 2^30, leaving room for the gain of 1.65
+    int64_t largest = std::max(vx, vy < 0 ? -vy : vy);
+    while (largest >= ((int64_t)1 << 30))
+    {
+        vx /= 2;
+        vy /= 2;
+        largest /= 2;
+    }
+    while (largest < ((int64_t)1 << 29))
+    {
+        vx *= 2;
+        vy *= 2;
+        largest *= 2;
+    }
+
+    for (int i = 0; i < FIXED_ATAN_STEPS; i++)
+    {
+        const int64_t dx = vx / ((int64_t)1 << i), dy = vy / ((int64_t)1 << i);
+        if (vy > 0)
+        {
+            vx += dy;
+            vy -= dx;
+            angle += steps[i];
+        }
+        else
+        {
+            vx -= dy;
+            vy += dx;
+            angle -= steps[i];
+        }
+    }
+
+    // What's left over can carry a vector just off the negative x axis past pi
+    angle = std::max(std::min(angle, pi), -pi + 1);
+    return T::FromRaw((Raw)FixedFromQ30(angle, FractionBits));
+}
+
+//----------------------------------------------------------------------------------
+// FixedVector2 functions, named as their Vector2 counterparts in Math.h
+//----------------------------------------------------------------------------------
+
+template<typename T>
+FixedVector2<T> operator+(const FixedVector2<T>& a, const FixedVector2<T>& b) { return { a.x + b.x, a.y + b.y }; }
+
+template<typename T>
+FixedVector2<T> operator-(const FixedVector2<T>& a, const FixedVector2<T>& b) { return { a.x - b.x, a.y - b.y }; }
+
+template<typename T>
+FixedVector2<T> operator*(const FixedVector2<T>& a, const FixedVector2<T>& b) { return { a.x * b.x, a.y * b.y }; }
+
+template<typename T>
+FixedVector2<T> operator*(const FixedVector2<T>& a, T b) { return { a.x * b, a.y * b }; }
+
+template<typename T>
+FixedVector2<T> operator/(const FixedVector2<T>& a, T b) { return { a.x / b, a.y / b }; }
+
+template<typename T>
+FixedVector2<T> Add(FixedVector2<T> v1, FixedVector2<T> v2) { return v1 + v2; }
+
+template<typename T>
+FixedVector2<T> Subtract(FixedVector2<T> v1, FixedVector2<T> v2) { return v1 - v2; }
+
+template<typename T>
+FixedVector2<T> Scale(FixedVector2<T> v, T scale) { return v * scale; }
+
+template<typename T>
+FixedVector2<T> Negate(FixedVector2<T> v) { return { -v.x, -v.y }; }
+
+template<typename T>
+T Dot(FixedVector2<T> v1, FixedVector2<T> v2) { return v1.x * v2.x + v1.y * v2.y; }
+
+template<typename T>
+T Cross(FixedVector2<T> v1, FixedVector2<T> v2) { return v1.x * v2.y - v1.y * v2.x; }
+
+template<typename T>
+T LengthSqr(FixedVector2<T> v) { return Dot(v, v); }
+
+template<typename T>
+T Length(FixedVector2<T> v) { return Sqrt(Dot(v, v)); }
+
+template<typename T>
+T DistanceSqr(FixedVector2<T> v1, FixedVector2<T> v2) { return LengthSqr(v1 - v2); }
+
+template<typename T>
+T Distance(FixedVector2<T> v1, FixedVector2<T> v2) { return Length(v1 - v2); }
+
+template<typename T>
+FixedVector2<T> Normalize(FixedVector2<T> v)
+{
+    const T length = Length(v);
+    return length > T() ? v / length : FixedVector2<T>{ T(), T() };
+}
+
+template<typename Raw, int FractionBits>
+FixedVector2<Fixed<Raw, FractionBits>> Direction(Fixed<Raw, FractionBits> angle) { return { Cos(angle), Sin(angle) }; }
+
+template<typename T>
+T Angle(FixedVector2<T> v1, FixedVector2<T> v2) { return Atan2(v2.y - v1.y, v2.x - v1.x); }
+
+template<typename T>
+FixedVector2<T> Rotate(FixedVector2<T> v, T angle)
+{
+    const T c = Cos(angle), s = Sin(angle);
+    return { v.x * c - v.y * s, v.x * s + v.y * c };
+}
+
+template<typename T>
+FixedVector2<T> Lerp(FixedVector2<T> v1, FixedVector2<T> v2, T amount) { return v1 + (v2 - v1) * amount; }
+
+// Point on line AB nearest to P
+template<typename T>
+FixedVector2<T> NearestPoint(FixedVector2<T> A, FixedVector2<T> B, FixedVector2<T> P)
+{
+    const FixedVector2<T> AB = B - A;
+    const T lengthSqr = Dot(AB, AB);
+    if (lengthSqr <= T()) return A;
+    return A + AB * Clamp(Dot(P - A, AB) / lengthSqr, T(), T(1));
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "raylib.h"
+#include "ObstacleGrid.h"
+#include "VirtualFileSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Obstacles to take out of and put into a level to turn one obstacle file into another
+struct ObstacleDiff
+{
+    std::vector<Rectangle> removed;
+    std::vector<Rectangle> added;
+};
+
+// Reads "x y width height" rectangles, one per line
+std::vector<Rectangle> LoadObstacles(const char* fileName)
+{
+    std::vector<Rectangle> obstacles;
+    AssetFile file = LoadAssetFile(fileName);
+    if (file.data == nullptr) return obstacles;
+
+    std::istringstream in(std::string((const char*)file.data, file.size));
+    UnloadAssetFile(file);
+
+    Rectangle obstacle;
+    while (in >> obstacle.x >> obstacle.y >> obstacle.width >> obstacle.height)
+        obstacles.push_back(obstacle);
+
+    return obstacles;
+}
+
+bool RectangleLess(const Rectangle& a, const Rectangle& b)
+{
+    if (a.x != b.x) return a.x < b.x;
+    if (a.y != b.y) return a.y < b.y;
+    if (a.width != b.width) return a.width < b.width;
+    return a.height < b.height;
+}
+
+// Multiset difference of two obstacle sets, O(n log n) so it can run on a loader thread
+ObstacleDiff DiffObstacles(std::vector<Rectangle> previous, std::vector<Rectangle> next)
+{
+    std::sort(previous.begin(), previous.end(), RectangleLess);
+    std::sort(next.begin(), next.end(), RectangleLess);
+
+    ObstacleDiff diff;
+    std::set_difference(previous.begin(), previous.end(), next.begin(), next.end(),
+        std::back_inserter(diff.removed), RectangleLess);
+    std::set_difference(next.begin(), next.end(), previous.begin(), previous.end(),
+        std::back_inserter(diff.added), RectangleLess);
+    return diff;
+}
+
+void ApplyObstacleDiff(ObstacleGrid& grid, const ObstacleDiff& diff)
+{
+    for (const Rectangle& obstacle : diff.removed)
+        grid.Remove(obstacle);
+    for (const Rectangle& obstacle : diff.added)
+        grid.Insert(obstacle);
+}
+
+// Box around everything the diff touches, false when it's empty
+bool GetObstacleDiffBounds(const ObstacleDiff& diff, Rectangle& bounds)
+{
+    float x0 = FLT_MAX, y0 = FLT_MAX, x1 = -FLT_MAX, y1 = -FLT_MAX;
+    for (const std::vector<Rectangle>* list : { &diff.removed, &diff.added })
+    {
+        for (const Rectangle& obstacle : *list)
+        {
+            x0 = std::min(x0, obstacle.x);
+            y0 = std::min(y0, obstacle.y);
+            x1 = std::max(x1, obstacle.x + obstacle.width);
+            y1 = std::max(y1, obstacle.y + obstacle.height);
+        }
+    }
+    if (x0 > x1) return false;
+
+    bounds = { x0, y0, x1 - x0, y1 - y0 };
+    return true;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "Collision.h"
+#include "ObstacleGrid.h"
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+// How far (world units) either endpoint may drift before a cached clear line of sight is re-tested
+#define LOS_CACHE_TOLERANCE 2.0f
+
+// Remembers the last answer for each viewer/target pair. Most frames nothing changes, so the obstacle that blocked
+// last time is tested first and a clear line is reused until an endpoint moves or the obstacles are edited.
+class LineOfSightCache
+{
+public:
+    // Same answer as IsSegmentBlocked. A blocked answer is always exact, a clear one may be up to
+    // LOS_CACHE_TOLERANCE out of date.
+    bool IsSegmentBlocked(int viewer, int target, Vector2 lineStart, Vector2 lineEnd, float distanceSqr,
+        const ObstacleGrid& obstacles)
+    {
+        mQueries++;
+        Entry& entry = mEntries[Key(viewer, target)];
+
+        // Ids are stable until removal and a reused id is still a live obstacle, so a hit is a hit whatever changed
+        if (entry.blocker >= 0 && obstacles.Contains(entry.blocker) &&
+            IsSegmentBlockedBy(lineStart, lineEnd, distanceSqr, obstacles.Get(entry.blocker)))
+        {
+            mHits++;
+            Store(entry, lineStart, lineEnd, distanceSqr, obstacles.Version(), entry.blocker);
+            return true;
+        }
+
+        const float toleranceSqr = LOS_CACHE_TOLERANCE * LOS_CACHE_TOLERANCE;
+        if (entry.valid && entry.blocker < 0 && entry.version == obstacles.Version() &&
+            DistanceSqr(entry.start, lineStart) <= toleranceSqr && DistanceSqr(entry.end, lineEnd) <= toleranceSqr &&
+            fabsf(sqrtf(entry.distanceSqr) - sqrtf(distanceSqr)) <= LOS_CACHE_TOLERANCE)
+        {
+            mHits++;
+            return false;
+        }
+
+        const int blocker = FindSegmentBlocker(lineStart, lineEnd, distanceSqr, obstacles);
+        Store(entry, lineStart, lineEnd, distanceSqr, obstacles.Version(), blocker);
+        return blocker >= 0;
+    }
+
+    // Drops the pair, call when a viewer or target goes away
+    void Forget(int viewer, int target)
+    {
+        mEntries.erase(Key(viewer, target));
+    }
+
+    void Clear()
+    {
+        mEntries.clear();
+        mQueries = 0;
+        mHits = 0;
+    }
+
+    // Queries answered without walking the grid
+    size_t Hits() const
+    {
+        return mHits;
+    }
+
+    size_t Queries() const
+    {
+        return mQueries;
+    }
+
+private:
+    struct Entry
+    {
+        Vector2 start{};
+        Vector2 end{};
+        float distanceSqr = 0.0f;
+        unsigned int version = 0;
+        int blocker = -1;
+        bool valid = false;
+    };
+
+    static void Store(Entry& entry, Vector2 lineStart, Vector2 lineEnd, float distanceSqr, unsigned int version, int blocker)
+    {
+        entry.start = lineStart;
+        entry.end = lineEnd;
+        entry.distanceSqr = distanceSqr;
+        entry.version = version;
+        entry.blocker = blocker;
+        entry.valid = true;
+    }
+
+    static uint64_t Key(int viewer, int target)
+    {
+        return ((uint64_t)(uint32_t)viewer << 32) | (uint32_t)target;
+    }
+
+    std::unordered_map<uint64_t, Entry> mEntries;
+    size_t mQueries = 0;
+    size_t mHits = 0;
+};
+
+// Determines if circle is visible from line start, reusing the pair's previous answer where possible
+bool IsCircleVisible(Vector2 lineStart, Vector2 lineEnd, Circle circle, const ObstacleGrid& obstacles,
+    LineOfSightCache& cache, int viewer, int target)
+{
+    if (!CheckCollisionLineCircle(lineStart, lineEnd, circle)) return false;
+    return !cache.IsSegmentBlocked(viewer, target, lineStart, lineEnd, DistanceSqr(lineStart, circle.position), obstacles);
+}
+
+// Determines if rectangle is visible from line start, reusing the pair's previous answer where possible
+bool IsRectangleVisible(Vector2 lineStart, Vector2 lineEnd, Rectangle rectangle, const ObstacleGrid& obstacles,
+    LineOfSightCache& cache, int viewer, int target)
+{
+    if (!CheckCollisionLineRec(lineStart, lineEnd, rectangle)) return false;
+    return !cache.IsSegmentBlocked(viewer, target, lineStart, lineEnd, DistanceSqr(lineStart,
+        { rectangle.x + rectangle.width * 0.5f, rectangle.y + rectangle.height * 0.5f }), obstacles);
+}
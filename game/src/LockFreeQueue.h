@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Bounded multi-producer multi-consumer queue (Dmitry Vyukov's sequence-numbered ring).
+// Push and pop never block or allocate; both fail instead when the ring is full or empty.
+template<typename T>
+class LockFreeQueue
+{
+public:
+    // Capacity is rounded up to a power of two
+    explicit LockFreeQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+
+        mMask = size - 1;
+        mCells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++)
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    bool TryPush(const T& value)
+    {
+        size_t position = mEnqueue.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = mCells[position & mMask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            ptrdiff_t difference = (ptrdiff_t)sequence - (ptrdiff_t)position;
+            if (difference == 0)
+            {
+                if (mEnqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) return false;
+            else position = mEnqueue.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool TryPop(T& value)
+    {
+        size_t position = mDequeue.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = mCells[position & mMask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            ptrdiff_t difference = (ptrdiff_t)sequence - (ptrdiff_t)(position + 1);
+            if (difference == 0)
+            {
+                if (mDequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    value = cell.value;
+                    cell.sequence.store(position + mMask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) return false;
+            else position = mDequeue.load(std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> mCells;
+    size_t mMask = 0;
+
+    // Separate cache lines so producers and the consumer don't false-share
+    alignas(64) std::atomic<size_t> mEnqueue{ 0 };
+    alignas(64) std::atomic<size_t> mDequeue{ 0 };
+};
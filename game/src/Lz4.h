@@ -0,0 +1,150 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// LZ4 block format (no frame), enough for pack entries that are compressed and decompressed whole
+#define LZ4_HASH_BITS 16
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5     // a block always ends with at least this many literals
+#define LZ4_MATCH_LIMIT 12      // and its last match starts at least this far from the end
+#define LZ4_MAX_OFFSET 65535
+
+// Worst case compressed size for incompressible input
+size_t Lz4CompressBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+uint32_t Lz4Read32(const unsigned char* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Lz4Hash(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+}
+
+unsigned char* Lz4WriteLength(unsigned char* op, size_t length)
+{
+    for (; length >= 255; length -= 255)
+        *op++ = 255;
+    *op++ = (unsigned char)length;
+    return op;
+}
+
+// Emits one sequence, a match length of zero marks the final literal run
+unsigned char* Lz4WriteSequence(unsigned char* op, const unsigned char* literals, size_t literalCount,
+    size_t offset, size_t matchLength)
+{
+    unsigned char* token = op++;
+    *token = (unsigned char)((literalCount >= 15 ? 15 : literalCount) << 4);
+    if (literalCount >= 15) op = Lz4WriteLength(op, literalCount - 15);
+    memcpy(op, literals, literalCount);
+    op += literalCount;
+
+    if (matchLength == 0) return op;
+
+    *op++ = (unsigned char)(offset & 0xFF);
+    *op++ = (unsigned char)(offset >> 8);
+    size_t extra = matchLength - LZ4_MIN_MATCH;
+    *token |= (unsigned char)(extra >= 15 ? 15 : extra);
+    if (extra >= 15) op = Lz4WriteLength(op, extra - 15);
+    return op;
+}
+
+// Greedy single-probe compressor, dst must hold Lz4CompressBound(srcSize) bytes. Returns the compressed size.
+size_t Lz4Compress(const unsigned char* src, size_t srcSize, unsigned char* dst)
+{
+    unsigned char* op = dst;
+    size_t anchor = 0;
+    if (srcSize > LZ4_MATCH_LIMIT)
+    {
+        std::vector<uint32_t> table((size_t)1 << LZ4_HASH_BITS, 0);
+        const size_t matchStartLimit = srcSize - LZ4_MATCH_LIMIT;
+        const size_t matchEndLimit = srcSize - LZ4_LAST_LITERALS;
+        size_t i = 0;
+        while (i < matchStartLimit)
+        {
+            const uint32_t sequence = Lz4Read32(src + i);
+            const uint32_t hash = Lz4Hash(sequence);
+            const size_t candidate = table[hash];
+            table[hash] = (uint32_t)i;
+
+            if (candidate >= i || i - candidate > LZ4_MAX_OFFSET || Lz4Read32(src + candidate) != sequence)
+            {
+                i++;
+                continue;
+            }
+
+            size_t end = i + LZ4_MIN_MATCH;
+            while (end < matchEndLimit && src[end] == src[candidate + end - i])
+                end++;
+
+            op = Lz4WriteSequence(op, src + anchor, i - anchor, i - candidate, end - i);
+            table[Lz4Hash(Lz4Read32(src + end - 2))] = (uint32_t)(end - 2);
+            i = end;
+            anchor = end;
+        }
+    }
+
+    op = Lz4WriteSequence(op, src + anchor, srcSize - anchor, 0, 0);
+    return (size_t)(op - dst);
+}
+
+bool Lz4ReadLength(const unsigned char*& ip, const unsigned char* ipEnd, size_t& length)
+{
+    unsigned char byte;
+    do
+    {
+        if (ip >= ipEnd) return false;
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// Decompresses a whole block into exactly dstSize bytes, false on malformed input
+bool Lz4Decompress(const unsigned char* src, size_t srcSize, unsigned char* dst, size_t dstSize)
+{
+    const unsigned char* ip = src;
+    const unsigned char* ipEnd = src + srcSize;
+    unsigned char* op = dst;
+    unsigned char* opEnd = dst + dstSize;
+
+    while (ip < ipEnd)
+    {
+        const unsigned char token = *ip++;
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !Lz4ReadLength(ip, ipEnd, literalCount)) return false;
+        if (literalCount > (size_t)(ipEnd - ip) || literalCount > (size_t)(opEnd - op)) return false;
+        memcpy(op, ip, literalCount);
+        ip += literalCount;
+        op += literalCount;
+
+        // The final sequence has no match
+        if (ip == ipEnd) break;
+
+        if (ipEnd - ip < 2) return false;
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !Lz4ReadLength(ip, ipEnd, matchLength)) return false;
+        matchLength += LZ4_MIN_MATCH;
+        if (matchLength > (size_t)(opEnd - op)) return false;
+
+        // Byte copy, matches may overlap their own output
+        const unsigned char* match = op - offset;
+        for (size_t i = 0; i < matchLength; i++)
+            op[i] = match[i];
+        op += matchLength;
+    }
+
+    return op == opEnd;
+}
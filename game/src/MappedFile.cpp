@@ -0,0 +1,80 @@
+// Kept out of the header so platform headers never meet raylib.h (Rectangle, CloseWindow, DrawText...)
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+MappedFile LoadMappedFile(const char* fileName)
+{
+    MappedFile file;
+    HANDLE handle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(handle);
+        return file;
+    }
+
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);
+    if (mapping == nullptr) return file;
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        return file;
+    }
+
+    file.data = static_cast<const unsigned char*>(data);
+    file.size = static_cast<size_t>(size.QuadPart);
+    file.handle = mapping;
+    return file;
+}
+
+void UnloadMappedFile(MappedFile& file)
+{
+    if (file.data != nullptr) UnmapViewOfFile(file.data);
+    if (file.handle != nullptr) CloseHandle(file.handle);
+    file = MappedFile{};
+}
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile LoadMappedFile(const char* fileName)
+{
+    MappedFile file;
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return file;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return file;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return file;
+
+    file.data = static_cast<const unsigned char*>(data);
+    file.size = static_cast<size_t>(info.st_size);
+    return file;
+}
+
+void UnloadMappedFile(MappedFile& file)
+{
+    if (file.data != nullptr) munmap(const_cast<unsigned char*>(file.data), file.size);
+    file = MappedFile{};
+}
+#endif
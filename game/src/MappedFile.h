@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+
+// Read-only view of a file mapped into memory
+struct MappedFile
+{
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    void* handle = nullptr;     // platform mapping handle, owned by the view
+};
+
+// Maps a whole file read-only, returns an empty view (data == nullptr) on failure
+MappedFile LoadMappedFile(const char* fileName);
+
+// Unmaps a view returned by LoadMappedFile
+void UnloadMappedFile(MappedFile& file);
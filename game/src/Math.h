@@ -1,11 +1,38 @@
 #pragma once
 #include <corecrt_math.h>
+#include <cstddef>
+#include <cstdint>
+
+// SSE2 is always there on x64. The AVX kernels are used when the compiler targets AVX (/arch:AVX, -mavx), the
+// scalar code when neither is available.
+#if defined(_M_X64) || defined(__SSE2__)
+#define MATH_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define MATH_AVX
+#include <immintrin.h>
+#endif
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
 #define RMAPI inline
 
+// Marks the functions that can run at compile time, everything that doesn't call into the C math library or the
+// SIMD kernels, so tables and fixed transforms can be built as constants
+#define RMCONSTEXPR constexpr
+
+// True while the compiler is evaluating a constant expression, Transpose, Invert and Multiply take their scalar
+// code then since intrinsics can't be folded
+#if (defined(_MSC_VER) && _MSC_VER >= 1925) || (defined(__clang__) && __clang_major__ >= 9) || \
+    (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 9)
+#define MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define MATH_CONSTANT_EVALUATED() false
+#endif
+
 #ifndef PI
 #define PI 3.14159265358979323846f
 #endif
@@ -96,7 +123,7 @@ typedef struct float16 {
 //----------------------------------------------------------------------------------
 
 // Clamp float value
-RMAPI float Clamp(float value, float min, float max)
+RMAPI RMCONSTEXPR float Clamp(float value, float min, float max)
 {
     float result = (value < min) ? min : value;
 
@@ -106,7 +133,7 @@ RMAPI float Clamp(float value, float min, float max)
 }
 
 // Calculate linear interpolation between two floats
-RMAPI float Lerp(float start, float end, float amount)
+RMAPI RMCONSTEXPR float Lerp(float start, float end, float amount)
 {
     float result = start + amount * (end - start);
 
@@ -114,7 +141,7 @@ RMAPI float Lerp(float start, float end, float amount)
 }
 
 // Normalize input value within input range
-RMAPI float Normalize(float value, float start, float end)
+RMAPI RMCONSTEXPR float Normalize(float value, float start, float end)
 {
     float result = (value - start) / (end - start);
 
@@ -122,7 +149,7 @@ RMAPI float Normalize(float value, float start, float end)
 }
 
 // Remap input value within input range to output range
-RMAPI float Remap(float value, float inputStart, float inputEnd, float outputStart, float outputEnd)
+RMAPI RMCONSTEXPR float Remap(float value, float inputStart, float inputEnd, float outputStart, float outputEnd)
 {
     float result = (value - inputStart) / (inputEnd - inputStart) * (outputEnd - outputStart) + outputStart;
 
@@ -146,7 +173,7 @@ RMAPI int Equals(float x, float y)
 }
 
 // Vector with components value 0.0f
-RMAPI Vector2 Vector2Zero(void)
+RMAPI RMCONSTEXPR Vector2 Vector2Zero(void)
 {
     Vector2 result = { 0.0f, 0.0f };
 
@@ -154,21 +181,21 @@ RMAPI Vector2 Vector2Zero(void)
 }
 
 // Vector with components value 1.0f
-RMAPI Vector2 Vector2One(void)
+RMAPI RMCONSTEXPR Vector2 Vector2One(void)
 {
     Vector2 result = { 1.0f, 1.0f };
 
     return result;
 }
 
-RMAPI Vector3 ToV3(Vector2 v)
+RMAPI RMCONSTEXPR Vector3 ToV3(Vector2 v)
 {
     Vector3 result = { v.x, v.y, 0.0f };
 
     return result;
 }
 
-RMAPI Vector2 FromV3(Vector3 v)
+RMAPI RMCONSTEXPR Vector2 FromV3(Vector3 v)
 {
     Vector2 result = { v.x, v.y };
 
@@ -176,7 +203,7 @@ RMAPI Vector2 FromV3(Vector3 v)
 }
 
 // Add two vectors (v1 + v2)
-RMAPI Vector2 Add(Vector2 v1, Vector2 v2)
+RMAPI RMCONSTEXPR Vector2 Add(Vector2 v1, Vector2 v2)
 {
     Vector2 result = { v1.x + v2.x, v1.y + v2.y };
 
@@ -184,7 +211,7 @@ RMAPI Vector2 Add(Vector2 v1, Vector2 v2)
 }
 
 // Add vector and float value
-RMAPI Vector2 Add(Vector2 v, float add)
+RMAPI RMCONSTEXPR Vector2 Add(Vector2 v, float add)
 {
     Vector2 result = { v.x + add, v.y + add };
 
@@ -192,7 +219,7 @@ RMAPI Vector2 Add(Vector2 v, float add)
 }
 
 // Subtract two vectors (v1 - v2)
-RMAPI Vector2 Subtract(Vector2 v1, Vector2 v2)
+RMAPI RMCONSTEXPR Vector2 Subtract(Vector2 v1, Vector2 v2)
 {
     Vector2 result = { v1.x - v2.x, v1.y - v2.y };
 
@@ -200,7 +227,7 @@ RMAPI Vector2 Subtract(Vector2 v1, Vector2 v2)
 }
 
 // Subtract vector by float value
-RMAPI Vector2 Subtract(Vector2 v, float sub)
+RMAPI RMCONSTEXPR Vector2 Subtract(Vector2 v, float sub)
 {
     Vector2 result = { v.x - sub, v.y - sub };
 
@@ -215,7 +242,7 @@ RMAPI float Length(Vector2 v)
 }
 
 // Calculate vector square length
-RMAPI float LengthSqr(Vector2 v)
+RMAPI RMCONSTEXPR float LengthSqr(Vector2 v)
 {
     float result = (v.x * v.x) + (v.y * v.y);
 
@@ -223,13 +250,21 @@ RMAPI float LengthSqr(Vector2 v)
 }
 
 // Calculate two vectors dot product
-RMAPI float Dot(Vector2 v1, Vector2 v2)
+RMAPI RMCONSTEXPR float Dot(Vector2 v1, Vector2 v2)
 {
     float result = (v1.x * v2.x + v1.y * v2.y);
 
     return result;
 }
 
+// Calculate two vectors cross product (z of the 3D cross product)
+RMAPI RMCONSTEXPR float Cross(Vector2 v1, Vector2 v2)
+{
+    float result = (v1.x * v2.y - v1.y * v2.x);
+
+    return result;
+}
+
 // Calculate distance between two vectors
 RMAPI float Distance(Vector2 v1, Vector2 v2)
 {
@@ -239,7 +274,7 @@ RMAPI float Distance(Vector2 v1, Vector2 v2)
 }
 
 // Calculate square distance between two vectors
-RMAPI float DistanceSqr(Vector2 v1, Vector2 v2)
+RMAPI RMCONSTEXPR float DistanceSqr(Vector2 v1, Vector2 v2)
 {
     float result = ((v1.x - v2.x) * (v1.x - v2.x) + (v1.y - v2.y) * (v1.y - v2.y));
 
@@ -280,7 +315,7 @@ RMAPI float LineAngle(Vector2 start, Vector2 end)
 }
 
 // Scale vector (multiply by value)
-RMAPI Vector2 Scale(Vector2 v, float scale)
+RMAPI RMCONSTEXPR Vector2 Scale(Vector2 v, float scale)
 {
     Vector2 result = { v.x * scale, v.y * scale };
 
@@ -288,14 +323,14 @@ RMAPI Vector2 Scale(Vector2 v, float scale)
 }
 
 // Project v1 onto v2
-RMAPI Vector2 Project(Vector2 v1, Vector2 v2)
+RMAPI RMCONSTEXPR Vector2 Project(Vector2 v1, Vector2 v2)
 {
     float t = Dot(v1, v2) / Dot(v2, v2);
     return { t * v2.x, t * v2.y };
 }
 
 // Returns the point on line AB nearest to point P
-RMAPI Vector2 NearestPoint(Vector2 A, Vector2 B, Vector2 P)
+RMAPI RMCONSTEXPR Vector2 NearestPoint(Vector2 A, Vector2 B, Vector2 P)
 {
     Vector2 AB = Subtract(B, A);
     float t = Dot(Subtract(P, A), AB) / Dot(AB, AB);
@@ -303,7 +338,7 @@ RMAPI Vector2 NearestPoint(Vector2 A, Vector2 B, Vector2 P)
 }
 
 // Multiply vector by vector
-RMAPI Vector2 Multiply(Vector2 v1, Vector2 v2)
+RMAPI RMCONSTEXPR Vector2 Multiply(Vector2 v1, Vector2 v2)
 {
     Vector2 result = { v1.x * v2.x, v1.y * v2.y };
 
@@ -311,7 +346,7 @@ RMAPI Vector2 Multiply(Vector2 v1, Vector2 v2)
 }
 
 // Negate vector
-RMAPI Vector2 Negate(Vector2 v)
+RMAPI RMCONSTEXPR Vector2 Negate(Vector2 v)
 {
     Vector2 result = { -v.x, -v.y };
 
@@ -319,7 +354,7 @@ RMAPI Vector2 Negate(Vector2 v)
 }
 
 // Divide vector by vector
-RMAPI Vector2 Divide(Vector2 v1, Vector2 v2)
+RMAPI RMCONSTEXPR Vector2 Divide(Vector2 v1, Vector2 v2)
 {
     Vector2 result = { v1.x / v2.x, v1.y / v2.y };
 
@@ -343,7 +378,7 @@ RMAPI Vector2 Normalize(Vector2 v)
 }
 
 // Transforms a Vector2 by a given Matrix
-RMAPI Vector2 Multiply(Vector2 v, Matrix mat)
+RMAPI RMCONSTEXPR Vector2 Multiply(Vector2 v, Matrix mat)
 {
     Vector2 result = { 0 };
 
@@ -358,7 +393,7 @@ RMAPI Vector2 Multiply(Vector2 v, Matrix mat)
 }
 
 // Calculate linear interpolation between two vectors
-RMAPI Vector2 Lerp(Vector2 v1, Vector2 v2, float amount)
+RMAPI RMCONSTEXPR Vector2 Lerp(Vector2 v1, Vector2 v2, float amount)
 {
     Vector2 result = { 0 };
 
@@ -369,7 +404,7 @@ RMAPI Vector2 Lerp(Vector2 v1, Vector2 v2, float amount)
 }
 
 // Calculate reflected vector to normal
-RMAPI Vector2 Reflect(Vector2 v, Vector2 normal)
+RMAPI RMCONSTEXPR Vector2 Reflect(Vector2 v, Vector2 normal)
 {
     Vector2 result = { 0 };
 
@@ -415,7 +450,7 @@ RMAPI Vector2 MoveTowards(Vector2 v, Vector2 target, float maxDistance)
 }
 
 // Invert the given vector
-RMAPI Vector2 Invert(Vector2 v)
+RMAPI RMCONSTEXPR Vector2 Invert(Vector2 v)
 {
     Vector2 result = { 1.0f / v.x, 1.0f / v.y };
 
@@ -475,7 +510,7 @@ RMAPI bool Equals(Vector2 p, Vector2 q)
 //----------------------------------------------------------------------------------
 
 // Vector with components value 0.0f
-RMAPI Vector3 Vector3Zero(void)
+RMAPI RMCONSTEXPR Vector3 Vector3Zero(void)
 {
     Vector3 result = { 0.0f, 0.0f, 0.0f };
 
@@ -483,7 +518,7 @@ RMAPI Vector3 Vector3Zero(void)
 }
 
 // Vector with components value 1.0f
-RMAPI Vector3 Vector3One(void)
+RMAPI RMCONSTEXPR Vector3 Vector3One(void)
 {
     Vector3 result = { 1.0f, 1.0f, 1.0f };
 
@@ -491,7 +526,7 @@ RMAPI Vector3 Vector3One(void)
 }
 
 // Add two vectors
-RMAPI Vector3 Add(Vector3 v1, Vector3 v2)
+RMAPI RMCONSTEXPR Vector3 Add(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.x + v2.x, v1.y + v2.y, v1.z + v2.z };
 
@@ -499,7 +534,7 @@ RMAPI Vector3 Add(Vector3 v1, Vector3 v2)
 }
 
 // Add vector and float value
-RMAPI Vector3 Add(Vector3 v, float add)
+RMAPI RMCONSTEXPR Vector3 Add(Vector3 v, float add)
 {
     Vector3 result = { v.x + add, v.y + add, v.z + add };
 
@@ -507,7 +542,7 @@ RMAPI Vector3 Add(Vector3 v, float add)
 }
 
 // Subtract two vectors
-RMAPI Vector3 Subtract(Vector3 v1, Vector3 v2)
+RMAPI RMCONSTEXPR Vector3 Subtract(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.x - v2.x, v1.y - v2.y, v1.z - v2.z };
 
@@ -515,7 +550,7 @@ RMAPI Vector3 Subtract(Vector3 v1, Vector3 v2)
 }
 
 // Subtract vector by float value
-RMAPI Vector3 Subtract(Vector3 v, float sub)
+RMAPI RMCONSTEXPR Vector3 Subtract(Vector3 v, float sub)
 {
     Vector3 result = { v.x - sub, v.y - sub, v.z - sub };
 
@@ -523,7 +558,7 @@ RMAPI Vector3 Subtract(Vector3 v, float sub)
 }
 
 // Multiply vector by scalar
-RMAPI Vector3 Scale(Vector3 v, float scalar)
+RMAPI RMCONSTEXPR Vector3 Scale(Vector3 v, float scalar)
 {
     Vector3 result = { v.x * scalar, v.y * scalar, v.z * scalar };
 
@@ -531,7 +566,7 @@ RMAPI Vector3 Scale(Vector3 v, float scalar)
 }
 
 // Multiply vector by vector
-RMAPI Vector3 Multiply(Vector3 v1, Vector3 v2)
+RMAPI RMCONSTEXPR Vector3 Multiply(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.x * v2.x, v1.y * v2.y, v1.z * v2.z };
 
@@ -539,7 +574,7 @@ RMAPI Vector3 Multiply(Vector3 v1, Vector3 v2)
 }
 
 // Calculate two vectors cross product
-RMAPI Vector3 Cross(Vector3 v1, Vector3 v2)
+RMAPI RMCONSTEXPR Vector3 Cross(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x };
 
@@ -584,7 +619,7 @@ RMAPI float Length(const Vector3 v)
 }
 
 // Calculate vector square length
-RMAPI float LengthSqr(const Vector3 v)
+RMAPI RMCONSTEXPR float LengthSqr(const Vector3 v)
 {
     float result = v.x * v.x + v.y * v.y + v.z * v.z;
 
@@ -592,7 +627,7 @@ RMAPI float LengthSqr(const Vector3 v)
 }
 
 // Calculate two vectors dot product
-RMAPI float Dot(Vector3 v1, Vector3 v2)
+RMAPI RMCONSTEXPR float Dot(Vector3 v1, Vector3 v2)
 {
     float result = (v1.x * v2.x + v1.y * v2.y + v1.z * v2.z);
 
@@ -613,7 +648,7 @@ RMAPI float Distance(Vector3 v1, Vector3 v2)
 }
 
 // Calculate square distance between two vectors
-RMAPI float DistanceSqr(Vector3 v1, Vector3 v2)
+RMAPI RMCONSTEXPR float DistanceSqr(Vector3 v1, Vector3 v2)
 {
     float result = 0.0f;
 
@@ -626,14 +661,14 @@ RMAPI float DistanceSqr(Vector3 v1, Vector3 v2)
 }
 
 // Project v1 onto v2
-RMAPI Vector3 Project(Vector3 v1, Vector3 v2)
+RMAPI RMCONSTEXPR Vector3 Project(Vector3 v1, Vector3 v2)
 {
     float t = Dot(v1, v2) / Dot(v2, v2);
     return { t * v2.x, t * v2.y, t * v2.z };
 }
 
 // Returns the point on line AB nearest to point P
-RMAPI Vector3 NearestPoint(Vector3 A, Vector3 B, Vector3 P)
+RMAPI RMCONSTEXPR Vector3 NearestPoint(Vector3 A, Vector3 B, Vector3 P)
 {
     Vector3 AB = Subtract(B, A);
     float t = Dot(Subtract(P, A), AB) / Dot(AB, AB);
@@ -654,7 +689,7 @@ RMAPI float Angle(Vector3 v1, Vector3 v2)
 }
 
 // Negate provided vector (invert direction)
-RMAPI Vector3 Negate(Vector3 v)
+RMAPI RMCONSTEXPR Vector3 Negate(Vector3 v)
 {
     Vector3 result = { -v.x, -v.y, -v.z };
 
@@ -662,7 +697,7 @@ RMAPI Vector3 Negate(Vector3 v)
 }
 
 // Divide vector by vector
-RMAPI Vector3 Divide(Vector3 v1, Vector3 v2)
+RMAPI RMCONSTEXPR Vector3 Divide(Vector3 v1, Vector3 v2)
 {
     Vector3 result = { v1.x / v2.x, v1.y / v2.y, v1.z / v2.z };
 
@@ -721,7 +756,7 @@ RMAPI void OrthoNormalize(Vector3* v1, Vector3* v2)
 }
 
 // Transforms a Vector3 by a given Matrix
-RMAPI Vector3 Multiply(Vector3 v, Matrix mat)
+RMAPI RMCONSTEXPR Vector3 Multiply(Vector3 v, Matrix mat)
 {
     Vector3 result = { 0 };
 
@@ -737,7 +772,7 @@ RMAPI Vector3 Multiply(Vector3 v, Matrix mat)
 }
 
 // Transform a vector by quaternion rotation
-RMAPI Vector3 Rotate(Vector3 v, Quaternion q)
+RMAPI RMCONSTEXPR Vector3 Rotate(Vector3 v, Quaternion q)
 {
     Vector3 result = { 0 };
 
@@ -801,7 +836,7 @@ RMAPI Vector3 Rotate(Vector3 v, Vector3 axis, float angle)
 }
 
 // Calculate linear interpolation between two vectors
-RMAPI Vector3 Lerp(Vector3 v1, Vector3 v2, float amount)
+RMAPI RMCONSTEXPR Vector3 Lerp(Vector3 v1, Vector3 v2, float amount)
 {
     Vector3 result = { 0 };
 
@@ -813,7 +848,7 @@ RMAPI Vector3 Lerp(Vector3 v1, Vector3 v2, float amount)
 }
 
 // Calculate reflected vector to normal
-RMAPI Vector3 Reflect(Vector3 v, Vector3 normal)
+RMAPI RMCONSTEXPR Vector3 Reflect(Vector3 v, Vector3 normal)
 {
     Vector3 result = { 0 };
 
@@ -856,7 +891,7 @@ RMAPI Vector3 Max(Vector3 v1, Vector3 v2)
 
 // Compute barycenter coordinates (u, v, w) for point p with respect to triangle (a, b, c)
 // NOTE: Assumes P is on the plane of the triangle
-RMAPI Vector3 Barycenter(Vector3 p, Vector3 a, Vector3 b, Vector3 c)
+RMAPI RMCONSTEXPR Vector3 Barycenter(Vector3 p, Vector3 a, Vector3 b, Vector3 c)
 {
     Vector3 result = { 0 };
 
@@ -880,7 +915,7 @@ RMAPI Vector3 Barycenter(Vector3 p, Vector3 a, Vector3 b, Vector3 c)
 
 // Projects a Vector3 from screen space into object space
 // NOTE: We are avoiding calling other raymath functions despite available
-RMAPI Vector3 Unproject(Vector3 source, Matrix projection, Matrix view)
+RMAPI RMCONSTEXPR Vector3 Unproject(Vector3 source, Matrix projection, Matrix view)
 {
     Vector3 result = { 0 };
 
@@ -963,7 +998,7 @@ RMAPI Vector3 Unproject(Vector3 source, Matrix projection, Matrix view)
 }
 
 // Get Vector3 as float array
-RMAPI float3 ToFloatV(Vector3 v)
+RMAPI RMCONSTEXPR float3 ToFloatV(Vector3 v)
 {
     float3 buffer = { 0 };
 
@@ -975,7 +1010,7 @@ RMAPI float3 ToFloatV(Vector3 v)
 }
 
 // Invert the given vector
-RMAPI Vector3 Invert(Vector3 v)
+RMAPI RMCONSTEXPR Vector3 Invert(Vector3 v)
 {
     Vector3 result = { 1.0f / v.x, 1.0f / v.y, 1.0f / v.z };
 
@@ -1060,12 +1095,245 @@ RMAPI Vector3 Refract(Vector3 v, Vector3 n, float r)
     return result;
 }
 
+//----------------------------------------------------------------------------------
+// Module Functions Definition - SIMD kernels
+//----------------------------------------------------------------------------------
+// Matrix fields are declared m0, m4, m8, m12, m1... so each group of four floats in memory is one row, the one
+// a vector is dotted with to get one of its components.
+
+#if defined(MATH_SSE)
+// Shuffle with the lanes in reading order, a and b from the first vector, c and d from the second
+#define MATH_SHUFFLE(first, second, a, b, c, d) _mm_shuffle_ps(first, second, _MM_SHUFFLE(d, c, b, a))
+
+// Same sums in the same order as the scalar Multiply, so the same result to the bit
+RMAPI Matrix MultiplySimd(Matrix left, Matrix right)
+{
+    Matrix result;
+    const float* l = (const float*)&left;
+    const float* r = (const float*)&right;
+    float* out = (float*)&result;
+
+    const __m128 l0 = _mm_loadu_ps(l + 0);
+    const __m128 l1 = _mm_loadu_ps(l + 4);
+    const __m128 l2 = _mm_loadu_ps(l + 8);
+    const __m128 l3 = _mm_loadu_ps(l + 12);
+    for (int row = 0; row < 4; row++)
+    {
+        const float* factors = r + row * 4;
+        __m128 sum = _mm_mul_ps(_mm_set1_ps(factors[0]), l0);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(factors[1]), l1));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(factors[2]), l2));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(factors[3]), l3));
+        _mm_storeu_ps(out + row * 4, sum);
+    }
+
+    return result;
+}
+
+RMAPI Matrix TransposeSimd(Matrix mat)
+{
+    Matrix result;
+    const float* m = (const float*)&mat;
+    __m128 row0 = _mm_loadu_ps(m + 0);
+    __m128 row1 = _mm_loadu_ps(m + 4);
+    __m128 row2 = _mm_loadu_ps(m + 8);
+    __m128 row3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    float* out = (float*)&result;
+    _mm_storeu_ps(out + 0, row0);
+    _mm_storeu_ps(out + 4, row1);
+    _mm_storeu_ps(out + 8, row2);
+    _mm_storeu_ps(out + 12, row3);
+
+    return result;
+}
+
+// 2x2 blocks packed as (a, b, c, d) = | a b |
+//                                     | c d |
+// first * second
+RMAPI __m128 Multiply2x2(__m128 first, __m128 second)
+{
+    return _mm_add_ps(_mm_mul_ps(first, MATH_SHUFFLE(second, second, 0, 3, 0, 3)),
+        _mm_mul_ps(MATH_SHUFFLE(first, first, 1, 0, 3, 2), MATH_SHUFFLE(second, second, 2, 1, 2, 1)));
+}
+
+// adjugate(first) * second
+RMAPI __m128 AdjugateMultiply2x2(__m128 first, __m128 second)
+{
+    return _mm_sub_ps(_mm_mul_ps(MATH_SHUFFLE(first, first, 3, 3, 0, 0), second),
+        _mm_mul_ps(MATH_SHUFFLE(first, first, 1, 1, 2, 2), MATH_SHUFFLE(second, second, 2, 3, 0, 1)));
+}
+
+// first * adjugate(second)
+RMAPI __m128 MultiplyAdjugate2x2(__m128 first, __m128 second)
+{
+    return _mm_sub_ps(_mm_mul_ps(first, MATH_SHUFFLE(second, second, 3, 0, 3, 0)),
+        _mm_mul_ps(MATH_SHUFFLE(first, first, 1, 0, 3, 2), MATH_SHUFFLE(second, second, 2, 1, 2, 1)));
+}
+
+// Inverse by 2x2 blocks | A B |, the inverse of a transpose is the transpose of the inverse so rows or columns
+//                       | C D |
+// makes no difference. The scalar Invert is this lane by lane, so the two agree to the bit.
+RMAPI Matrix InvertSimd(Matrix mat)
+{
+    const float* m = (const float*)&mat;
+    const __m128 row0 = _mm_loadu_ps(m + 0);
+    const __m128 row1 = _mm_loadu_ps(m + 4);
+    const __m128 row2 = _mm_loadu_ps(m + 8);
+    const __m128 row3 = _mm_loadu_ps(m + 12);
+
+    const __m128 a = _mm_movelh_ps(row0, row1);
+    const __m128 b = _mm_movehl_ps(row1, row0);
+    const __m128 c = _mm_movelh_ps(row2, row3);
+    const __m128 d = _mm_movehl_ps(row3, row2);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 determinants = _mm_sub_ps(
+        _mm_mul_ps(MATH_SHUFFLE(row0, row2, 0, 2, 0, 2), MATH_SHUFFLE(row1, row3, 1, 3, 1, 3)),
+        _mm_mul_ps(MATH_SHUFFLE(row0, row2, 1, 3, 1, 3), MATH_SHUFFLE(row1, row3, 0, 2, 0, 2)));
+    const __m128 detA = MATH_SHUFFLE(determinants, determinants, 0, 0, 0, 0);
+    const __m128 detB = MATH_SHUFFLE(determinants, determinants, 1, 1, 1, 1);
+    const __m128 detC = MATH_SHUFFLE(determinants, determinants, 2, 2, 2, 2);
+    const __m128 detD = MATH_SHUFFLE(determinants, determinants, 3, 3, 3, 3);
+
+    // The inverse is | X Y | / |M|, built from the adjugates of X, Y, Z and W
+    //                | Z W |
+    const __m128 adjDC = AdjugateMultiply2x2(d, c);
+    const __m128 adjAB = AdjugateMultiply2x2(a, b);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Multiply2x2(b, adjDC));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Multiply2x2(c, adjAB));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), MultiplyAdjugate2x2(d, adjAB));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), MultiplyAdjugate2x2(a, adjDC));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m128 trace = _mm_mul_ps(adjAB, MATH_SHUFFLE(adjDC, adjDC, 0, 2, 1, 3));
+    trace = _mm_add_ps(trace, MATH_SHUFFLE(trace, trace, 2, 3, 0, 1));
+    trace = _mm_add_ps(trace, MATH_SHUFFLE(trace, trace, 1, 0, 3, 2));
+    const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+    // Adjugate signs folded into the reciprocal
+    const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+    x = _mm_mul_ps(x, invDet);
+    y = _mm_mul_ps(y, invDet);
+    z = _mm_mul_ps(z, invDet);
+    w = _mm_mul_ps(w, invDet);
+
+    // Taking the adjugates back and interleaving the blocks into rows in one shuffle each
+    Matrix result;
+    float* out = (float*)&result;
+    _mm_storeu_ps(out + 0, MATH_SHUFFLE(x, y, 3, 1, 3, 1));
+    _mm_storeu_ps(out + 4, MATH_SHUFFLE(x, y, 2, 0, 2, 0));
+    _mm_storeu_ps(out + 8, MATH_SHUFFLE(z, w, 3, 1, 3, 1));
+    _mm_storeu_ps(out + 12, MATH_SHUFFLE(z, w, 2, 0, 2, 0));
+
+    return result;
+}
+#endif
+
+// Transforms count points by mat, the same as Multiply(Vector2, Matrix) on each. in and out may be the same
+// array. Points are handled singly until in is aligned, then with aligned loads.
+RMAPI void Multiply(const Vector2* in, Vector2* out, size_t count, Matrix mat)
+{
+    size_t i = 0;
+#if defined(MATH_SSE)
+#if defined(MATH_AVX)
+    const size_t alignment = 32;
+#else
+    const size_t alignment = 16;
+#endif
+    for (; i < count && ((uintptr_t)(in + i) & (alignment - 1)) != 0; i++)
+    {
+        out[i] = { mat.m0 * in[i].x + mat.m4 * in[i].y + mat.m12, mat.m1 * in[i].x + mat.m5 * in[i].y + mat.m13 };
+    }
+
+#if defined(MATH_AVX)
+    // (x, x, ...) * (m0, m1, ...) + (y, y, ...) * (m4, m5, ...) + (m12, m13, ...), four points at a time
+    const __m256 xs = _mm256_setr_ps(mat.m0, mat.m1, mat.m0, mat.m1, mat.m0, mat.m1, mat.m0, mat.m1);
+    const __m256 ys = _mm256_setr_ps(mat.m4, mat.m5, mat.m4, mat.m5, mat.m4, mat.m5, mat.m4, mat.m5);
+    const __m256 ts = _mm256_setr_ps(mat.m12, mat.m13, mat.m12, mat.m13, mat.m12, mat.m13, mat.m12, mat.m13);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256 points = _mm256_load_ps((const float*)(in + i));
+        __m256 sum = _mm256_mul_ps(_mm256_moveldup_ps(points), xs);
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_movehdup_ps(points), ys));
+        _mm256_storeu_ps((float*)(out + i), _mm256_add_ps(sum, ts));
+    }
+#else
+    const __m128 xs = _mm_setr_ps(mat.m0, mat.m1, mat.m0, mat.m1);
+    const __m128 ys = _mm_setr_ps(mat.m4, mat.m5, mat.m4, mat.m5);
+    const __m128 ts = _mm_setr_ps(mat.m12, mat.m13, mat.m12, mat.m13);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128 points = _mm_load_ps((const float*)(in + i));
+        __m128 sum = _mm_mul_ps(MATH_SHUFFLE(points, points, 0, 0, 2, 2), xs);
+        sum = _mm_add_ps(sum, _mm_mul_ps(MATH_SHUFFLE(points, points, 1, 1, 3, 3), ys));
+        _mm_storeu_ps((float*)(out + i), _mm_add_ps(sum, ts));
+    }
+#endif
+#endif
+
+    for (; i < count; i++)
+    {
+        out[i] = { mat.m0 * in[i].x + mat.m4 * in[i].y + mat.m12, mat.m1 * in[i].x + mat.m5 * in[i].y + mat.m13 };
+    }
+}
+
+// Transforms count points by mat, the same as Multiply(Vector3, Matrix) on each. in and out may be the same
+// array. Points are handled singly until in is aligned, then four at a time as three aligned loads.
+RMAPI void Multiply(const Vector3* in, Vector3* out, size_t count, Matrix mat)
+{
+    size_t i = 0;
+#if defined(MATH_SSE)
+    for (; i < count && ((uintptr_t)(in + i) & 15) != 0; i++)
+    {
+        const Vector3 v = in[i];
+        out[i] = { mat.m0 * v.x + mat.m4 * v.y + mat.m8 * v.z + mat.m12,
+            mat.m1 * v.x + mat.m5 * v.y + mat.m9 * v.z + mat.m13,
+            mat.m2 * v.x + mat.m6 * v.y + mat.m10 * v.z + mat.m14 };
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 to x0 x1 x2 x3 | y0 y1 y2 y3 | z0 z1 z2 z3
+        const float* source = (const float*)(in + i);
+        const __m128 a = _mm_load_ps(source + 0);
+        const __m128 b = _mm_load_ps(source + 4);
+        const __m128 c = _mm_load_ps(source + 8);
+        const __m128 x = MATH_SHUFFLE(a, MATH_SHUFFLE(b, c, 2, 2, 1, 1), 0, 3, 0, 2);
+        const __m128 y = MATH_SHUFFLE(MATH_SHUFFLE(a, b, 1, 1, 0, 0), MATH_SHUFFLE(b, c, 3, 3, 2, 2), 0, 2, 0, 2);
+        const __m128 z = MATH_SHUFFLE(MATH_SHUFFLE(a, b, 2, 2, 1, 1), c, 0, 2, 0, 3);
+
+        const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(mat.m0), x),
+            _mm_mul_ps(_mm_set1_ps(mat.m4), y)), _mm_mul_ps(_mm_set1_ps(mat.m8), z)), _mm_set1_ps(mat.m12));
+        const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(mat.m1), x),
+            _mm_mul_ps(_mm_set1_ps(mat.m5), y)), _mm_mul_ps(_mm_set1_ps(mat.m9), z)), _mm_set1_ps(mat.m13));
+        const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(mat.m2), x),
+            _mm_mul_ps(_mm_set1_ps(mat.m6), y)), _mm_mul_ps(_mm_set1_ps(mat.m10), z)), _mm_set1_ps(mat.m14));
+
+        // And back
+        float* target = (float*)(out + i);
+        _mm_storeu_ps(target + 0, MATH_SHUFFLE(MATH_SHUFFLE(rx, ry, 0, 0, 0, 0), MATH_SHUFFLE(rz, rx, 0, 0, 1, 1), 0, 2, 0, 2));
+        _mm_storeu_ps(target + 4, MATH_SHUFFLE(MATH_SHUFFLE(ry, rz, 1, 1, 1, 1), MATH_SHUFFLE(rx, ry, 2, 2, 2, 2), 0, 2, 0, 2));
+        _mm_storeu_ps(target + 8, MATH_SHUFFLE(MATH_SHUFFLE(rz, rx, 2, 2, 3, 3), MATH_SHUFFLE(ry, rz, 3, 3, 3, 3), 0, 2, 0, 2));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const Vector3 v = in[i];
+        out[i] = { mat.m0 * v.x + mat.m4 * v.y + mat.m8 * v.z + mat.m12,
+            mat.m1 * v.x + mat.m5 * v.y + mat.m9 * v.z + mat.m13,
+            mat.m2 * v.x + mat.m6 * v.y + mat.m10 * v.z + mat.m14 };
+    }
+}
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Matrix math
 //----------------------------------------------------------------------------------
 
 // Compute matrix determinant
-RMAPI float Determinant(Matrix mat)
+RMAPI RMCONSTEXPR float Determinant(Matrix mat)
 {
     float result = 0.0f;
 
@@ -1086,7 +1354,7 @@ RMAPI float Determinant(Matrix mat)
 }
 
 // Get the trace of the matrix (sum of the values along the diagonal)
-RMAPI float Trace(Matrix mat)
+RMAPI RMCONSTEXPR float Trace(Matrix mat)
 {
     float result = (mat.m0 + mat.m5 + mat.m10 + mat.m15);
 
@@ -1094,8 +1362,11 @@ RMAPI float Trace(Matrix mat)
 }
 
 // Transposes provided matrix
-RMAPI Matrix Transpose(Matrix mat)
+RMAPI RMCONSTEXPR Matrix Transpose(Matrix mat)
 {
+#if defined(MATH_SSE)
+    if (!MATH_CONSTANT_EVALUATED()) return TransposeSimd(mat);
+#endif
     Matrix result = { 0 };
 
     result.m0 = mat.m0;
@@ -1119,54 +1390,80 @@ RMAPI Matrix Transpose(Matrix mat)
 }
 
 // Invert provided matrix
-RMAPI Matrix Invert(Matrix mat)
+// NOTE: Without SIMD, and at compile time, this is InvertSimd lane by lane with the same products and sums in the
+// same order, so both give the same inverse to the bit
+RMAPI RMCONSTEXPR Matrix Invert(Matrix mat)
 {
+#if defined(MATH_SSE)
+    if (!MATH_CONSTANT_EVALUATED()) return InvertSimd(mat);
+#endif
     Matrix result = { 0 };
 
-    // Cache the matrix values (speed optimization)
-    float a00 = mat.m0, a01 = mat.m1, a02 = mat.m2, a03 = mat.m3;
-    float a10 = mat.m4, a11 = mat.m5, a12 = mat.m6, a13 = mat.m7;
-    float a20 = mat.m8, a21 = mat.m9, a22 = mat.m10, a23 = mat.m11;
-    float a30 = mat.m12, a31 = mat.m13, a32 = mat.m14, a33 = mat.m15;
-
-    float b00 = a00 * a11 - a01 * a10;
-    float b01 = a00 * a12 - a02 * a10;
-    float b02 = a00 * a13 - a03 * a10;
-    float b03 = a01 * a12 - a02 * a11;
-    float b04 = a01 * a13 - a03 * a11;
-    float b05 = a02 * a13 - a03 * a12;
-    float b06 = a20 * a31 - a21 * a30;
-    float b07 = a20 * a32 - a22 * a30;
-    float b08 = a20 * a33 - a23 * a30;
-    float b09 = a21 * a32 - a22 * a31;
-    float b10 = a21 * a33 - a23 * a31;
-    float b11 = a22 * a33 - a23 * a32;
-
-    // Calculate the invert determinant (inlined to avoid double-caching)
-    float invDet = 1.0f / (b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06);
-
-    result.m0 = (a11 * b11 - a12 * b10 + a13 * b09) * invDet;
-    result.m1 = (-a01 * b11 + a02 * b10 - a03 * b09) * invDet;
-    result.m2 = (a31 * b05 - a32 * b04 + a33 * b03) * invDet;
-    result.m3 = (-a21 * b05 + a22 * b04 - a23 * b03) * invDet;
-    result.m4 = (-a10 * b11 + a12 * b08 - a13 * b07) * invDet;
-    result.m5 = (a00 * b11 - a02 * b08 + a03 * b07) * invDet;
-    result.m6 = (-a30 * b05 + a32 * b02 - a33 * b01) * invDet;
-    result.m7 = (a20 * b05 - a22 * b02 + a23 * b01) * invDet;
-    result.m8 = (a10 * b10 - a11 * b08 + a13 * b06) * invDet;
-    result.m9 = (-a00 * b10 + a01 * b08 - a03 * b06) * invDet;
-    result.m10 = (a30 * b04 - a31 * b02 + a33 * b00) * invDet;
-    result.m11 = (-a20 * b04 + a21 * b02 - a23 * b00) * invDet;
-    result.m12 = (-a10 * b09 + a11 * b07 - a12 * b06) * invDet;
-    result.m13 = (a00 * b09 - a01 * b07 + a02 * b06) * invDet;
-    result.m14 = (-a30 * b03 + a31 * b01 - a32 * b00) * invDet;
-    result.m15 = (a20 * b03 - a21 * b01 + a22 * b00) * invDet;
+    // 2x2 blocks packed as in InvertSimd, (p0, p1, p2, p3) = | p0 p1 |
+    //                                                       | p2 p3 |
+    const float a[4] = { mat.m0, mat.m4, mat.m1, mat.m5 };
+    const float b[4] = { mat.m8, mat.m12, mat.m9, mat.m13 };
+    const float c[4] = { mat.m2, mat.m6, mat.m3, mat.m7 };
+    const float d[4] = { mat.m10, mat.m14, mat.m11, mat.m15 };
+
+    const float detA = a[0] * a[3] - a[1] * a[2];
+    const float detB = b[0] * b[3] - b[1] * b[2];
+    const float detC = c[0] * c[3] - c[1] * c[2];
+    const float detD = d[0] * d[3] - d[1] * d[2];
+
+    // adj(D)C and adj(A)B
+    const float adjDC[4] = { d[3] * c[0] - d[1] * c[2], d[3] * c[1] - d[1] * c[3],
+                             d[0] * c[2] - d[2] * c[0], d[0] * c[3] - d[2] * c[1] };
+    const float adjAB[4] = { a[3] * b[0] - a[1] * b[2], a[3] * b[1] - a[1] * b[3],
+                             a[0] * b[2] - a[2] * b[0], a[0] * b[3] - a[2] * b[1] };
+
+    // X = |D|A - B adj(D)C, W = |A|D - C adj(A)B, Y = |B|C - D adj(adj(A)B), Z = |C|B - A adj(adj(D)C)
+    const float x[4] = { detD * a[0] - (b[0] * adjDC[0] + b[1] * adjDC[2]),
+                         detD * a[1] - (b[0] * adjDC[1] + b[1] * adjDC[3]),
+                         detD * a[2] - (b[2] * adjDC[0] + b[3] * adjDC[2]),
+                         detD * a[3] - (b[2] * adjDC[1] + b[3] * adjDC[3]) };
+    const float w[4] = { detA * d[0] - (c[0] * adjAB[0] + c[1] * adjAB[2]),
+                         detA * d[1] - (c[0] * adjAB[1] + c[1] * adjAB[3]),
+                         detA * d[2] - (c[2] * adjAB[0] + c[3] * adjAB[2]),
+                         detA * d[3] - (c[2] * adjAB[1] + c[3] * adjAB[3]) };
+    const float y[4] = { detB * c[0] - (d[0] * adjAB[3] - d[1] * adjAB[2]),
+                         detB * c[1] - (d[1] * adjAB[0] - d[0] * adjAB[1]),
+                         detB * c[2] - (d[2] * adjAB[3] - d[3] * adjAB[2]),
+                         detB * c[3] - (d[3] * adjAB[0] - d[2] * adjAB[1]) };
+    const float z[4] = { detC * b[0] - (a[0] * adjDC[3] - a[1] * adjDC[2]),
+                         detC * b[1] - (a[1] * adjDC[0] - a[0] * adjDC[1]),
+                         detC * b[2] - (a[2] * adjDC[3] - a[3] * adjDC[2]),
+                         detC * b[3] - (a[3] * adjDC[0] - a[2] * adjDC[1]) };
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C), the trace summed in pairs like the SIMD lanes
+    const float trace = (adjAB[0] * adjDC[0] + adjAB[2] * adjDC[1]) + (adjAB[1] * adjDC[2] + adjAB[3] * adjDC[3]);
+    const float det = (detA * detD + detB * detC) - trace;
+    const float invDet = 1.0f / det;
+    const float negInvDet = -1.0f / det;
+
+    // Adjugates of the blocks, interleaved back into rows
+    result.m0 = x[3] * invDet;
+    result.m4 = x[1] * negInvDet;
+    result.m8 = y[3] * invDet;
+    result.m12 = y[1] * negInvDet;
+    result.m1 = x[2] * negInvDet;
+    result.m5 = x[0] * invDet;
+    result.m9 = y[2] * negInvDet;
+    result.m13 = y[0] * invDet;
+    result.m2 = z[3] * invDet;
+    result.m6 = z[1] * negInvDet;
+    result.m10 = w[3] * invDet;
+    result.m14 = w[1] * negInvDet;
+    result.m3 = z[2] * negInvDet;
+    result.m7 = z[0] * invDet;
+    result.m11 = w[2] * negInvDet;
+    result.m15 = w[0] * invDet;
 
     return result;
 }
 
 // Get identity matrix
-RMAPI Matrix MatrixIdentity(void)
+RMAPI RMCONSTEXPR Matrix MatrixIdentity(void)
 {
     Matrix result = { 1.0f, 0.0f, 0.0f, 0.0f,
                       0.0f, 1.0f, 0.0f, 0.0f,
@@ -1177,7 +1474,7 @@ RMAPI Matrix MatrixIdentity(void)
 }
 
 // Add two matrices
-RMAPI Matrix Add(Matrix left, Matrix right)
+RMAPI RMCONSTEXPR Matrix Add(Matrix left, Matrix right)
 {
     Matrix result = { 0 };
 
@@ -1202,7 +1499,7 @@ RMAPI Matrix Add(Matrix left, Matrix right)
 }
 
 // Subtract two matrices (left - right)
-RMAPI Matrix Subtract(Matrix left, Matrix right)
+RMAPI RMCONSTEXPR Matrix Subtract(Matrix left, Matrix right)
 {
     Matrix result = { 0 };
 
@@ -1228,8 +1525,11 @@ RMAPI Matrix Subtract(Matrix left, Matrix right)
 
 // Get two matrix multiplication
 // NOTE: When multiplying matrices... the order matters!
-RMAPI Matrix Multiply(Matrix left, Matrix right)
+RMAPI RMCONSTEXPR Matrix Multiply(Matrix left, Matrix right)
 {
+#if defined(MATH_SSE)
+    if (!MATH_CONSTANT_EVALUATED()) return MultiplySimd(left, right);
+#endif
     Matrix result = { 0 };
 
     result.m0 = left.m0 * right.m0 + left.m1 * right.m4 + left.m2 * right.m8 + left.m3 * right.m12;
@@ -1253,7 +1553,7 @@ RMAPI Matrix Multiply(Matrix left, Matrix right)
 }
 
 // Get translation matrix
-RMAPI Matrix Translate(float x, float y, float z)
+RMAPI RMCONSTEXPR Matrix Translate(float x, float y, float z)
 {
     Matrix result = { 1.0f, 0.0f, 0.0f, x,
                       0.0f, 1.0f, 0.0f, y,
@@ -1437,7 +1737,7 @@ RMAPI Matrix RotateZYX(Vector3 angle)
 }
 
 // Get scaling matrix
-RMAPI Matrix Scale(float x, float y, float z)
+RMAPI RMCONSTEXPR Matrix Scale(float x, float y, float z)
 {
     Matrix result = { x, 0.0f, 0.0f, 0.0f,
                       0.0f, y, 0.0f, 0.0f,
@@ -1448,7 +1748,7 @@ RMAPI Matrix Scale(float x, float y, float z)
 }
 
 // Get perspective projection matrix
-RMAPI Matrix Frustum(double left, double right, double bottom, double top, double near, double far)
+RMAPI RMCONSTEXPR Matrix Frustum(double left, double right, double bottom, double top, double near, double far)
 {
     Matrix result = { 0 };
 
@@ -1507,7 +1807,7 @@ RMAPI Matrix Perspective(double fovy, double aspect, double near, double far)
 }
 
 // Get orthographic projection matrix
-RMAPI Matrix Ortho(double left, double right, double bottom, double top, double near, double far)
+RMAPI RMCONSTEXPR Matrix Ortho(double left, double right, double bottom, double top, double near, double far)
 {
     Matrix result = { 0 };
 
@@ -1591,7 +1891,7 @@ RMAPI Matrix LookAt(Vector3 eye, Vector3 target, Vector3 up)
 }
 
 // Get float array of matrix data
-RMAPI float16 ToFloatV(Matrix mat)
+RMAPI RMCONSTEXPR float16 ToFloatV(Matrix mat)
 {
     float16 result = { 0 };
 
@@ -1620,7 +1920,7 @@ RMAPI float16 ToFloatV(Matrix mat)
 //----------------------------------------------------------------------------------
 
 // Add two quaternions
-RMAPI Quaternion Add(Quaternion q1, Quaternion q2)
+RMAPI RMCONSTEXPR Quaternion Add(Quaternion q1, Quaternion q2)
 {
     Quaternion result = { q1.x + q2.x, q1.y + q2.y, q1.z + q2.z, q1.w + q2.w };
 
@@ -1628,7 +1928,7 @@ RMAPI Quaternion Add(Quaternion q1, Quaternion q2)
 }
 
 // Add quaternion and float value
-RMAPI Quaternion Add(Quaternion q, float add)
+RMAPI RMCONSTEXPR Quaternion Add(Quaternion q, float add)
 {
     Quaternion result = { q.x + add, q.y + add, q.z + add, q.w + add };
 
@@ -1636,7 +1936,7 @@ RMAPI Quaternion Add(Quaternion q, float add)
 }
 
 // Subtract two quaternions
-RMAPI Quaternion Subtract(Quaternion q1, Quaternion q2)
+RMAPI RMCONSTEXPR Quaternion Subtract(Quaternion q1, Quaternion q2)
 {
     Quaternion result = { q1.x - q2.x, q1.y - q2.y, q1.z - q2.z, q1.w - q2.w };
 
@@ -1644,7 +1944,7 @@ RMAPI Quaternion Subtract(Quaternion q1, Quaternion q2)
 }
 
 // Subtract quaternion and float value
-RMAPI Quaternion Subtract(Quaternion q, float sub)
+RMAPI RMCONSTEXPR Quaternion Subtract(Quaternion q, float sub)
 {
     Quaternion result = { q.x - sub, q.y - sub, q.z - sub, q.w - sub };
 
@@ -1652,7 +1952,7 @@ RMAPI Quaternion Subtract(Quaternion q, float sub)
 }
 
 // Get identity quaternion
-RMAPI Quaternion QuaternionIdentity(void)
+RMAPI RMCONSTEXPR Quaternion QuaternionIdentity(void)
 {
     Quaternion result = { 0.0f, 0.0f, 0.0f, 1.0f };
 
@@ -1685,7 +1985,7 @@ RMAPI Quaternion Normalize(Quaternion q)
 }
 
 // Invert provided quaternion
-RMAPI Quaternion Invert(Quaternion q)
+RMAPI RMCONSTEXPR Quaternion Invert(Quaternion q)
 {
     Quaternion result = q;
 
@@ -1705,7 +2005,7 @@ RMAPI Quaternion Invert(Quaternion q)
 }
 
 // Calculate two quaternion multiplication
-RMAPI Quaternion Multiply(Quaternion q1, Quaternion q2)
+RMAPI RMCONSTEXPR Quaternion Multiply(Quaternion q1, Quaternion q2)
 {
     Quaternion result = { 0 };
 
@@ -1721,7 +2021,7 @@ RMAPI Quaternion Multiply(Quaternion q1, Quaternion q2)
 }
 
 // Scale quaternion by float value
-RMAPI Quaternion Scale(Quaternion q, float mul)
+RMAPI RMCONSTEXPR Quaternion Scale(Quaternion q, float mul)
 {
     Quaternion result = { 0 };
 
@@ -1734,7 +2034,7 @@ RMAPI Quaternion Scale(Quaternion q, float mul)
 }
 
 // Divide two quaternions
-RMAPI Quaternion Divide(Quaternion q1, Quaternion q2)
+RMAPI RMCONSTEXPR Quaternion Divide(Quaternion q1, Quaternion q2)
 {
     Quaternion result = { q1.x / q2.x, q1.y / q2.y, q1.z / q2.z, q1.w / q2.w };
 
@@ -1742,7 +2042,7 @@ RMAPI Quaternion Divide(Quaternion q1, Quaternion q2)
 }
 
 // Calculate linear interpolation between two quaternions
-RMAPI Quaternion Lerp(Quaternion q1, Quaternion q2, float amount)
+RMAPI RMCONSTEXPR Quaternion Lerp(Quaternion q1, Quaternion q2, float amount)
 {
     Quaternion result = { 0 };
 
@@ -1914,7 +2214,7 @@ RMAPI Quaternion FromMatrix(Matrix mat)
 }
 
 // Get a matrix for a given quaternion
-RMAPI Matrix ToMatrix(Quaternion q)
+RMAPI RMCONSTEXPR Matrix ToMatrix(Quaternion q)
 {
     Matrix result = { 1.0f, 0.0f, 0.0f, 0.0f,
                       0.0f, 1.0f, 0.0f, 0.0f,
@@ -2076,7 +2376,7 @@ RMAPI Vector3 ToEuler(Quaternion q)
 }
 
 // Transform a quaternion given a transformation matrix
-RMAPI Quaternion Multiply(Quaternion q, Matrix mat)
+RMAPI RMCONSTEXPR Quaternion Multiply(Quaternion q, Matrix mat)
 {
     Quaternion result = { 0 };
 
@@ -2107,137 +2407,137 @@ RMAPI int Equals(Quaternion p, Quaternion q)
 // Module Functions Definition - Global operator overloads
 //----------------------------------------------------------------------------------
 
-RMAPI Vector2 operator+(const Vector2& a, const Vector2& b)
+RMAPI RMCONSTEXPR Vector2 operator+(const Vector2& a, const Vector2& b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector2 operator-(const Vector2& a, const Vector2& b)
+RMAPI RMCONSTEXPR Vector2 operator-(const Vector2& a, const Vector2& b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector2 operator*(const Vector2& a, const Vector2& b)
+RMAPI RMCONSTEXPR Vector2 operator*(const Vector2& a, const Vector2& b)
 {
     return Multiply(a, b);
 }
 
-RMAPI Vector2 operator/(const Vector2& a, const Vector2& b)
+RMAPI RMCONSTEXPR Vector2 operator/(const Vector2& a, const Vector2& b)
 {
     return Divide(a, b);
 }
 
-RMAPI Vector2 operator+(const Vector2& a, float b)
+RMAPI RMCONSTEXPR Vector2 operator+(const Vector2& a, float b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector2 operator-(const Vector2& a, float b)
+RMAPI RMCONSTEXPR Vector2 operator-(const Vector2& a, float b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector2 operator*(const Vector2& a, float b)
+RMAPI RMCONSTEXPR Vector2 operator*(const Vector2& a, float b)
 {
     return Scale(a, b);
 }
 
-RMAPI Vector3 operator+(const Vector3& a, const Vector3& b)
+RMAPI RMCONSTEXPR Vector3 operator+(const Vector3& a, const Vector3& b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector3 operator-(const Vector3& a, const Vector3& b)
+RMAPI RMCONSTEXPR Vector3 operator-(const Vector3& a, const Vector3& b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector3 operator*(const Vector3& a, const Vector3& b)
+RMAPI RMCONSTEXPR Vector3 operator*(const Vector3& a, const Vector3& b)
 {
     return Multiply(a, b);
 }
 
-RMAPI Vector3 operator/(const Vector3& a, const Vector3& b)
+RMAPI RMCONSTEXPR Vector3 operator/(const Vector3& a, const Vector3& b)
 {
     return Divide(a, b);
 }
 
-RMAPI Vector3 operator+(const Vector3& a, float b)
+RMAPI RMCONSTEXPR Vector3 operator+(const Vector3& a, float b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector3 operator-(const Vector3& a, float b)
+RMAPI RMCONSTEXPR Vector3 operator-(const Vector3& a, float b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector3 operator*(const Vector3& a, float b)
+RMAPI RMCONSTEXPR Vector3 operator*(const Vector3& a, float b)
 {
     return Scale(a, b);
 }
 
-RMAPI Vector3 operator/(const Vector3& a, float b)
+RMAPI RMCONSTEXPR Vector3 operator/(const Vector3& a, float b)
 {
     return Scale(a, 1.0f / b);
 }
 
-RMAPI Vector4 operator+(const Vector4& a, const Vector4& b)
+RMAPI RMCONSTEXPR Vector4 operator+(const Vector4& a, const Vector4& b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector4 operator-(const Vector4& a, const Vector4& b)
+RMAPI RMCONSTEXPR Vector4 operator-(const Vector4& a, const Vector4& b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector4 operator*(const Vector4& a, const Vector4& b)
+RMAPI RMCONSTEXPR Vector4 operator*(const Vector4& a, const Vector4& b)
 {
     return Multiply(a, b);
 }
 
-RMAPI Vector4 operator/(const Vector4& a, const Vector4& b)
+RMAPI RMCONSTEXPR Vector4 operator/(const Vector4& a, const Vector4& b)
 {
     return Divide(a, b);
 }
 
-RMAPI Vector4 operator+(const Vector4& a, float b)
+RMAPI RMCONSTEXPR Vector4 operator+(const Vector4& a, float b)
 {
     return Add(a, b);
 }
 
-RMAPI Vector4 operator-(const Vector4& a, float b)
+RMAPI RMCONSTEXPR Vector4 operator-(const Vector4& a, float b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Vector4 operator*(const Vector4& a, float b)
+RMAPI RMCONSTEXPR Vector4 operator*(const Vector4& a, float b)
 {
     return Scale(a, b);
 }
 
-RMAPI Vector4 operator/(const Vector4& a, float b)
+RMAPI RMCONSTEXPR Vector4 operator/(const Vector4& a, float b)
 {
     return Scale(a, 1.0f / b);
 }
 
-RMAPI Vector2 operator/(const Vector2& a, float b)
+RMAPI RMCONSTEXPR Vector2 operator/(const Vector2& a, float b)
 {
     return Scale(a, 1.0f / b);
 }
 
-RMAPI Matrix operator+(const Matrix& a, const Matrix& b)
+RMAPI RMCONSTEXPR Matrix operator+(const Matrix& a, const Matrix& b)
 {
     return Add(a, b);
 }
 
-RMAPI Matrix operator-(const Matrix& a, const Matrix& b)
+RMAPI RMCONSTEXPR Matrix operator-(const Matrix& a, const Matrix& b)
 {
     return Subtract(a, b);
 }
 
-RMAPI Matrix operator*(const Matrix& a, const Matrix& b)
+RMAPI RMCONSTEXPR Matrix operator*(const Matrix& a, const Matrix& b)
 {
     return Multiply(a, b);
 }
@@ -0,0 +1,860 @@
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include "Math.h"
+#include "MeshData.h"
+#include "MeshLod.h"
+#include "MeshOptimizer.h"
+#include "ThreadPool.h"
+#include "VirtualFileSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Bump whenever the layout written by SerializeMesh changes, stale caches are re-imported
+#define MESH_CACHE_VERSION 3
+#define MESH_CACHE_EXTENSION ".mesh"
+
+// raylib meshes index with unsigned short, so cached meshes are split into submeshes of at most this many vertices
+#define MESH_CACHE_MAX_SUBMESH_VERTICES 65535
+
+// Header flags
+#define MESH_CACHE_QUANTIZED 1      // vertices stored as QuantizedVertex instead of float streams
+#define MESH_CACHE_LODS 2           // levels beyond lod 0 were generated
+#define MESH_CACHE_OPTIMIZED 4      // levels were reordered by OptimizeMesh
+
+// Half float vertex attributes need GL 3.0, older contexts get quantized caches expanded back to floats
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_43)
+#define MESH_GL_QUANTIZED_ATTRIBUTES
+#endif
+
+// GL types rlgl doesn't name
+#define MESH_GL_SHORT 0x1402
+#define MESH_GL_HALF_FLOAT 0x140B
+
+// raylib's UnloadMesh walks MAX_MESH_VERTEX_BUFFERS vbo slots, which isn't exported; over-allocate
+#define MESH_VERTEX_BUFFER_SLOTS 16
+
+struct MeshImportOptions
+{
+    bool optimize = true;       // vertex cache, overdraw and vertex fetch ordering
+    bool quantize = false;      // 16-byte QuantizedVertex instead of 32 bytes of floats
+    bool generateLods = true;   // simplified levels for LoadLodModelCached
+};
+
+// Header flags a cache written with these options carries
+uint32_t MeshCacheFlags(const MeshImportOptions& options)
+{
+    return (options.quantize ? MESH_CACHE_QUANTIZED : 0) | (options.generateLods ? MESH_CACHE_LODS : 0) |
+        (options.optimize ? MESH_CACHE_OPTIMIZED : 0);
+}
+
+// Cache file layout (little-endian):
+// MeshCacheHeader, MeshCacheLod[lodCount], MeshCacheSubmesh[submeshCount], then per submesh at its offset either
+// positions float[3 * vertexCount], normals float[3 * vertexCount], texcoords float[2 * vertexCount], indices uint16[indexCount]
+// or, when MESH_CACHE_QUANTIZED is set,
+// vertices QuantizedVertex[vertexCount], indices uint16[indexCount]
+struct MeshCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    int64_t sourceModTime;
+    uint32_t lodCount;
+    uint32_t submeshCount;
+    uint32_t flags;
+    float boundsMin[3];
+    float boundsMax[3];
+    float quantizeCenter[3];
+    float quantizeScale;
+};
+
+// Level of detail, finest first, owning a run of consecutive submeshes
+struct MeshCacheLod
+{
+    uint32_t firstSubmesh;
+    uint32_t submeshCount;
+    float error;                // object-space deviation from lod 0
+    uint32_t reserved;
+};
+
+struct MeshCacheSubmesh
+{
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint64_t offset;
+};
+
+//----------------------------------------------------------------------------------
+// OBJ import
+//----------------------------------------------------------------------------------
+
+// One corner of an OBJ face. Indices are 1-based; relative (negative) indices are
+// stored chunk-local and flagged, since the chunk doesn't know how many elements came before it
+struct ObjCorner
+{
+    int32_t position;
+    int32_t texcoord;
+    int32_t normal;
+    uint8_t relative;
+};
+
+// Everything parsed from one newline-aligned slice of the file
+struct ObjChunk
+{
+    std::vector<Vector3> positions;
+    std::vector<Vector2> texcoords;
+    std::vector<Vector3> normals;
+    std::vector<ObjCorner> corners;     // triangulated, 3 per triangle
+};
+
+struct ObjCornerKey
+{
+    int32_t position;
+    int32_t texcoord;
+    int32_t normal;
+
+    bool operator==(const ObjCornerKey& other) const
+    {
+        return position == other.position && texcoord == other.texcoord && normal == other.normal;
+    }
+};
+
+struct ObjCornerKeyHash
+{
+    size_t operator()(const ObjCornerKey& key) const
+    {
+        uint64_t h = (uint32_t)key.position * 0x9E3779B97F4A7C15ull;
+        h ^= ((uint32_t)key.texcoord + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+        h ^= ((uint32_t)key.normal + 0x165667B19E3779F9ull) * 0x85EBCA77C2B2AE63ull;
+        return (size_t)(h ^ (h >> 29));
+    }
+};
+
+const char* SkipObjSpaces(const char* c, const char* end)
+{
+    while (c < end && (*c == ' ' || *c == '\t')) c++;
+    return c;
+}
+
+// strtof needs a terminator, which a mapped file doesn't have at its end
+float ParseObjFloat(const char*& c, const char* end)
+{
+    c = SkipObjSpaces(c, end);
+
+    bool negative = false;
+    if (c < end && (*c == '-' || *c == '+')) negative = *c++ == '-';
+
+    double value = 0.0;
+    while (c < end && *c >= '0' && *c <= '9') value = value * 10.0 + (*c++ - '0');
+
+    if (c < end && *c == '.')
+    {
+        c++;
+        double scale = 0.1;
+        while (c < end && *c >= '0' && *c <= '9')
+        {
+            value += (*c++ - '0') * scale;
+            scale *= 0.1;
+        }
+    }
+
+    if (c < end && (*c == 'e' || *c == 'E'))
+    {
+        c++;
+        bool negativeExponent = false;
+        if (c < end && (*c == '-' || *c == '+')) negativeExponent = *c++ == '-';
+
+        int exponent = 0;
+        while (c < end && *c >= '0' && *c <= '9') exponent = exponent * 10 + (*c++ - '0');
+        value *= pow(10.0, negativeExponent ? -exponent : exponent);
+    }
+
+    return (float)(negative ? -value : value);
+}
+
+int32_t ParseObjInt(const char*& c, const char* end)
+{
+    bool negative = false;
+    if (c < end && (*c == '-' || *c == '+')) negative = *c++ == '-';
+
+    int32_t value = 0;
+    while (c < end && *c >= '0' && *c <= '9') value = value * 10 + (*c++ - '0');
+
+    return negative ? -value : value;
+}
+
+// Parses "v/t/n", "v//n", "v/t" or "v" into a corner
+bool ParseObjCorner(const char*& c, const char* end, const ObjChunk& chunk, ObjCorner& corner)
+{
+    c = SkipObjSpaces(c, end);
+    if (c >= end || *c == '\r' || *c == '#') return false;
+
+    int32_t values[3] = { 0, 0, 0 };
+    const int32_t counts[3] =
+    {
+        (int32_t)chunk.positions.size(),
+        (int32_t)chunk.texcoords.size(),
+        (int32_t)chunk.normals.size()
+    };
+
+    const char* start = c;
+    corner.relative = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        values[i] = ParseObjInt(c, end);
+        if (values[i] < 0)
+        {
+            values[i] += counts[i] + 1;
+            corner.relative |= 1 << i;
+        }
+        if (c >= end || *c != '/') break;
+        c++;
+    }
+    if (c == start || (values[0] == 0 && !(corner.relative & 1))) return false;
+
+    corner.position = values[0];
+    corner.texcoord = values[1];
+    corner.normal = values[2];
+    return true;
+}
+
+void ParseObjChunk(const char* c, const char* end, ObjChunk& chunk)
+{
+    while (c < end)
+    {
+        const char* lineEnd = (const char*)memchr(c, '\n', end - c);
+        if (lineEnd == nullptr) lineEnd = end;
+
+        c = SkipObjSpaces(c, lineEnd);
+        if (lineEnd - c >= 2 && c[0] == 'v' && c[1] == ' ')
+        {
+            c += 2;
+            Vector3 position;
+            position.x = ParseObjFloat(c, lineEnd);
+            position.y = ParseObjFloat(c, lineEnd);
+            position.z = ParseObjFloat(c, lineEnd);
+            chunk.positions.push_back(position);
+        }
+        else if (lineEnd - c >= 3 && c[0] == 'v' && c[1] == 't' && c[2] == ' ')
+        {
+            c += 3;
+            Vector2 texcoord;
+            texcoord.x = ParseObjFloat(c, lineEnd);
+            texcoord.y = ParseObjFloat(c, lineEnd);
+            chunk.texcoords.push_back(texcoord);
+        }
+        else if (lineEnd - c >= 3 && c[0] == 'v' && c[1] == 'n' && c[2] == ' ')
+        {
+            c += 3;
+            Vector3 normal;
+            normal.x = ParseObjFloat(c, lineEnd);
+            normal.y = ParseObjFloat(c, lineEnd);
+            normal.z = ParseObjFloat(c, lineEnd);
+            chunk.normals.push_back(normal);
+        }
+        else if (lineEnd - c >= 2 && c[0] == 'f' && c[1] == ' ')
+        {
+            // Triangulate polygons as a fan around the first corner
+            c += 2;
+            ObjCorner first, previous, current;
+            int count = 0;
+            while (ParseObjCorner(c, lineEnd, chunk, current))
+            {
+                if (count == 0) first = current;
+                else if (count >= 2)
+                {
+                    chunk.corners.push_back(first);
+                    chunk.corners.push_back(previous);
+                    chunk.corners.push_back(current);
+                }
+                previous = current;
+                count++;
+            }
+        }
+
+        c = lineEnd + 1;
+    }
+}
+
+// Area-weighted smooth normals, used when the file has no "vn" records
+void GenerateNormals(MeshData& mesh)
+{
+    for (MeshVertex& vertex : mesh.vertices)
+        vertex.normal = Vector3Zero();
+
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+    {
+        MeshVertex& a = mesh.vertices[mesh.indices[i]];
+        MeshVertex& b = mesh.vertices[mesh.indices[i + 1]];
+        MeshVertex& c = mesh.vertices[mesh.indices[i + 2]];
+        Vector3 normal = Cross(b.position - a.position, c.position - a.position);
+        a.normal = a.normal + normal;
+        b.normal = b.normal + normal;
+        c.normal = c.normal + normal;
+    }
+
+    for (MeshVertex& vertex : mesh.vertices)
+        vertex.normal = Normalize(vertex.normal);
+}
+
+// Parses an OBJ in parallel slices and welds identical position/texcoord/normal corners into an indexed mesh
+bool ImportObj(const char* fileName, MeshData& mesh, ThreadPool& pool = DefaultThreadPool())
+{
+    AssetFile file = LoadAssetFile(fileName);
+    if (file.data == nullptr)
+    {
+        TraceLog(LOG_WARNING, "MESH: [%s] Failed to open OBJ file", fileName);
+        return false;
+    }
+
+    const char* text = (const char*)file.data;
+    const char* textEnd = text + file.size;
+
+    // Slice on line boundaries, roughly 256KB per chunk
+    const size_t chunkBytes = 256 * 1024;
+    std::vector<const char*> bounds{ text };
+    while (bounds.back() < textEnd)
+    {
+        const char* next = bounds.back() + chunkBytes;
+        if (next >= textEnd) next = textEnd;
+        else
+        {
+            const char* newline = (const char*)memchr(next, '\n', textEnd - next);
+            next = newline == nullptr ? textEnd : newline + 1;
+        }
+        bounds.push_back(next);
+    }
+
+    std::vector<ObjChunk> chunks(bounds.size() - 1);
+    ParallelFor(pool, chunks.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+            ParseObjChunk(bounds[i], bounds[i + 1], chunks[i]);
+    });
+    UnloadAssetFile(file);
+
+    std::vector<Vector3> positions;
+    std::vector<Vector2> texcoords;
+    std::vector<Vector3> normals;
+    std::vector<int32_t> positionBase, texcoordBase, normalBase;
+    size_t cornerCount = 0;
+    for (const ObjChunk& chunk : chunks)
+    {
+        positionBase.push_back((int32_t)positions.size());
+        texcoordBase.push_back((int32_t)texcoords.size());
+        normalBase.push_back((int32_t)normals.size());
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        cornerCount += chunk.corners.size();
+    }
+
+    const bool hasNormals = !normals.empty();
+    std::unordered_map<ObjCornerKey, uint32_t, ObjCornerKeyHash> welded;
+    welded.reserve(cornerCount / 2);
+
+    mesh.vertices.clear();
+    mesh.indices.clear();
+    mesh.indices.reserve(cornerCount);
+    for (size_t c = 0; c < chunks.size(); c++)
+    {
+        for (const ObjCorner& corner : chunks[c].corners)
+        {
+            // Resolve to 0-based absolute indices, -1 when absent
+            ObjCornerKey key;
+            key.position = corner.position + ((corner.relative & 1) ? positionBase[c] : 0) - 1;
+            key.texcoord = corner.texcoord + ((corner.relative & 2) ? texcoordBase[c] : 0) - 1;
+            key.normal = hasNormals ? corner.normal + ((corner.relative & 4) ? normalBase[c] : 0) - 1 : -1;
+
+            if (key.position < 0 || key.position >= (int32_t)positions.size() ||
+                key.texcoord >= (int32_t)texcoords.size() || key.normal >= (int32_t)normals.size())
+            {
+                TraceLog(LOG_WARNING, "MESH: [%s] Face references a missing vertex", fileName);
+                return false;
+            }
+
+            auto inserted = welded.insert({ key, (uint32_t)mesh.vertices.size() });
+            if (inserted.second)
+            {
+                // raylib's OBJ loader flips V, keep the same convention
+                MeshVertex vertex;
+                vertex.position = positions[key.position];
+                vertex.normal = key.normal >= 0 ? normals[key.normal] : Vector3Zero();
+                vertex.texcoord = key.texcoord >= 0 ?
+                    Vector2{ texcoords[key.texcoord].x, 1.0f - texcoords[key.texcoord].y } : Vector2Zero();
+                mesh.vertices.push_back(vertex);
+            }
+            mesh.indices.push_back(inserted.first->second);
+        }
+    }
+
+    if (mesh.vertices.empty())
+    {
+        TraceLog(LOG_WARNING, "MESH: [%s] OBJ file has no faces", fileName);
+        return false;
+    }
+
+    if (!hasNormals) GenerateNormals(mesh);
+
+    mesh.boundsMin = mesh.boundsMax = mesh.vertices[0].position;
+    for (const MeshVertex& vertex : mesh.vertices)
+    {
+        mesh.boundsMin = Min(mesh.boundsMin, vertex.position);
+        mesh.boundsMax = Max(mesh.boundsMax, vertex.position);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Binary cache
+//----------------------------------------------------------------------------------
+
+size_t MeshCacheSubmeshBytes(uint32_t vertexCount, uint32_t indexCount, uint32_t flags)
+{
+    size_t vertexBytes = (flags & MESH_CACHE_QUANTIZED) ? sizeof(QuantizedVertex) : (3 + 3 + 2) * sizeof(float);
+    size_t bytes = vertexCount * vertexBytes + indexCount * sizeof(uint16_t);
+    return (bytes + 15) & ~(size_t)15;
+}
+
+// Splits a mesh into runs of triangles whose vertices fit 16-bit indices
+struct MeshCacheSplit
+{
+    std::vector<uint32_t> vertices;     // source vertex of each local vertex
+    std::vector<uint16_t> indices;
+};
+
+std::vector<MeshCacheSplit> SplitMesh(const MeshData& mesh)
+{
+    std::vector<MeshCacheSplit> submeshes(1);
+    std::vector<uint32_t> localIndex(mesh.vertices.size());
+    std::vector<uint32_t> localStamp(mesh.vertices.size(), 0);
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+    {
+        MeshCacheSplit* submesh = &submeshes.back();
+        uint32_t stamp = (uint32_t)submeshes.size();
+
+        size_t added = 0;
+        for (size_t j = 0; j < 3; j++)
+            added += localStamp[mesh.indices[i + j]] != stamp;
+
+        if (submesh->vertices.size() + added > MESH_CACHE_MAX_SUBMESH_VERTICES)
+        {
+            submeshes.emplace_back();
+            submesh = &submeshes.back();
+            stamp = (uint32_t)submeshes.size();
+        }
+
+        for (size_t j = 0; j < 3; j++)
+        {
+            uint32_t index = mesh.indices[i + j];
+            if (localStamp[index] != stamp)
+            {
+                localStamp[index] = stamp;
+                localIndex[index] = (uint32_t)submesh->vertices.size();
+                submesh->vertices.push_back(index);
+            }
+            submesh->indices.push_back((uint16_t)localIndex[index]);
+        }
+    }
+    return submeshes;
+}
+
+// Lays every level out exactly as it will be uploaded. All levels share lods[0]'s quantisation frame.
+std::vector<unsigned char> SerializeMesh(const std::vector<MeshData>& lods, const std::vector<float>& lodErrors,
+    long sourceModTime, uint32_t flags)
+{
+    std::vector<std::vector<MeshCacheSplit>> splits;
+    size_t submeshCount = 0;
+    for (const MeshData& lod : lods)
+    {
+        splits.push_back(SplitMesh(lod));
+        submeshCount += splits.back().size();
+    }
+
+    size_t tableBytes = sizeof(MeshCacheHeader) + lods.size() * sizeof(MeshCacheLod) + submeshCount * sizeof(MeshCacheSubmesh);
+    size_t offset = (tableBytes + 15) & ~(size_t)15;
+    size_t totalBytes = offset;
+    for (const std::vector<MeshCacheSplit>& split : splits)
+    {
+        for (const MeshCacheSplit& submesh : split)
+            totalBytes += MeshCacheSubmeshBytes((uint32_t)submesh.vertices.size(), (uint32_t)submesh.indices.size(), flags);
+    }
+
+    std::vector<unsigned char> blob(totalBytes, 0);
+
+    Vector3 quantizeCenter;
+    float quantizeScale;
+    QuantizationFrame(lods[0], quantizeCenter, quantizeScale);
+
+    MeshCacheHeader* header = (MeshCacheHeader*)blob.data();
+    memcpy(header->magic, "SMSH", 4);
+    header->version = MESH_CACHE_VERSION;
+    header->sourceModTime = sourceModTime;
+    header->lodCount = (uint32_t)lods.size();
+    header->submeshCount = (uint32_t)submeshCount;
+    header->flags = flags;
+    memcpy(header->boundsMin, &lods[0].boundsMin, sizeof(header->boundsMin));
+    memcpy(header->boundsMax, &lods[0].boundsMax, sizeof(header->boundsMax));
+    memcpy(header->quantizeCenter, &quantizeCenter, sizeof(header->quantizeCenter));
+    header->quantizeScale = quantizeScale;
+
+    MeshCacheLod* lodTable = (MeshCacheLod*)(blob.data() + sizeof(MeshCacheHeader));
+    MeshCacheSubmesh* table = (MeshCacheSubmesh*)(lodTable + lods.size());
+    size_t s = 0;
+    for (size_t l = 0; l < lods.size(); l++)
+    {
+        lodTable[l].firstSubmesh = (uint32_t)s;
+        lodTable[l].submeshCount = (uint32_t)splits[l].size();
+        lodTable[l].error = lodErrors[l];
+
+        for (const MeshCacheSplit& submesh : splits[l])
+        {
+            uint32_t vertexCount = (uint32_t)submesh.vertices.size();
+            table[s].vertexCount = vertexCount;
+            table[s].indexCount = (uint32_t)submesh.indices.size();
+            table[s].offset = offset;
+
+            unsigned char* indices = nullptr;
+            if (flags & MESH_CACHE_QUANTIZED)
+            {
+                QuantizedVertex* vertices = (QuantizedVertex*)(blob.data() + offset);
+                for (uint32_t v = 0; v < vertexCount; v++)
+                    vertices[v] = QuantizeVertex(lods[l].vertices[submesh.vertices[v]], quantizeCenter, quantizeScale);
+                indices = (unsigned char*)(vertices + vertexCount);
+            }
+            else
+            {
+                float* positions = (float*)(blob.data() + offset);
+                float* normals = positions + vertexCount * 3;
+                float* texcoords = normals + vertexCount * 3;
+                for (uint32_t v = 0; v < vertexCount; v++)
+                {
+                    const MeshVertex& vertex = lods[l].vertices[submesh.vertices[v]];
+                    memcpy(positions + v * 3, &vertex.position, sizeof(float) * 3);
+                    memcpy(normals + v * 3, &vertex.normal, sizeof(float) * 3);
+                    memcpy(texcoords + v * 2, &vertex.texcoord, sizeof(float) * 2);
+                }
+                indices = (unsigned char*)(texcoords + vertexCount * 2);
+            }
+            memcpy(indices, submesh.indices.data(), submesh.indices.size() * sizeof(uint16_t));
+
+            offset += MeshCacheSubmeshBytes(vertexCount, table[s].indexCount, flags);
+            s++;
+        }
+    }
+
+    return blob;
+}
+
+const MeshCacheLod* MeshCacheLods(const unsigned char* data)
+{
+    return (const MeshCacheLod*)(data + sizeof(MeshCacheHeader));
+}
+
+const MeshCacheSubmesh* MeshCacheSubmeshes(const unsigned char* data)
+{
+    return (const MeshCacheSubmesh*)(MeshCacheLods(data) + ((const MeshCacheHeader*)data)->lodCount);
+}
+
+// Checks that a cache blob is complete, current, was written with the given flags
+// and (if sourceModTime != 0) built from that source
+bool ValidateMeshCache(const unsigned char* data, size_t size, long sourceModTime, uint32_t flags)
+{
+    if (data == nullptr || size < sizeof(MeshCacheHeader)) return false;
+
+    const MeshCacheHeader* header = (const MeshCacheHeader*)data;
+    if (memcmp(header->magic, "SMSH", 4) != 0 || header->version != MESH_CACHE_VERSION) return false;
+    if (sourceModTime != 0 && header->sourceModTime != sourceModTime) return false;
+    if (header->flags != flags || header->quantizeScale <= 0.0f) return false;
+    if (header->lodCount == 0 || header->submeshCount == 0 || sizeof(MeshCacheHeader) +
+        header->lodCount * sizeof(MeshCacheLod) + header->submeshCount * sizeof(MeshCacheSubmesh) > size) return false;
+
+    const MeshCacheLod* lods = MeshCacheLods(data);
+    for (uint32_t l = 0; l < header->lodCount; l++)
+    {
+        if (lods[l].submeshCount == 0 || lods[l].firstSubmesh + lods[l].submeshCount > header->submeshCount) return false;
+    }
+
+    const MeshCacheSubmesh* table = MeshCacheSubmeshes(data);
+    for (uint32_t s = 0; s < header->submeshCount; s++)
+    {
+        if (table[s].vertexCount > MESH_CACHE_MAX_SUBMESH_VERTICES || table[s].indexCount % 3 != 0) return false;
+        if (table[s].offset % 16 != 0 ||
+            table[s].offset + MeshCacheSubmeshBytes(table[s].vertexCount, table[s].indexCount, flags) > size) return false;
+    }
+
+    return true;
+}
+
+#if defined(MESH_GL_QUANTIZED_ATTRIBUTES)
+// Builds the vertex array by hand since UploadMesh only takes float streams.
+// Position and normal are normalized shorts, texcoord is half float, all from one interleaved buffer.
+void UploadQuantizedMesh(Mesh& mesh, const QuantizedVertex* vertices)
+{
+    const int stride = (int)sizeof(QuantizedVertex);
+
+    mesh.vboId = (unsigned int*)MemAlloc(sizeof(unsigned int) * MESH_VERTEX_BUFFER_SLOTS);
+    mesh.vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(mesh.vaoId);
+
+    mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION] = rlLoadVertexBuffer(vertices, mesh.vertexCount * stride, false);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 3, MESH_GL_SHORT, true, stride, (int)offsetof(QuantizedVertex, position));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL, 3, MESH_GL_SHORT, true, stride, (int)offsetof(QuantizedVertex, normal));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, 2, MESH_GL_HALF_FLOAT, false, stride, (int)offsetof(QuantizedVertex, texcoord));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
+
+    mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES] =
+        rlLoadVertexBufferElement(mesh.indices, mesh.triangleCount * 3 * sizeof(unsigned short), false);
+
+    rlDisableVertexArray();
+}
+#endif
+
+// Fills the mesh's float arrays from cache vertices in raylib's allocator, so UnloadModel frees them. Quantized
+// vertices are expanded in the quantisation frame, the model transform still undoes it.
+void CopyMeshArrays(Mesh& mesh, const unsigned char* vertices, bool quantized)
+{
+    const int count = mesh.vertexCount;
+    mesh.vertices = (float*)MemAlloc(count * 3 * sizeof(float));
+    mesh.normals = (float*)MemAlloc(count * 3 * sizeof(float));
+    mesh.texcoords = (float*)MemAlloc(count * 2 * sizeof(float));
+
+    if (!quantized)
+    {
+        const float* positions = (const float*)vertices;
+        memcpy(mesh.vertices, positions, count * 3 * sizeof(float));
+        memcpy(mesh.normals, positions + count * 3, count * 3 * sizeof(float));
+        memcpy(mesh.texcoords, positions + count * 6, count * 2 * sizeof(float));
+        return;
+    }
+
+    const QuantizedVertex* quantizedVertices = (const QuantizedVertex*)vertices;
+    for (int v = 0; v < count; v++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            mesh.vertices[v * 3 + i] = fmaxf(quantizedVertices[v].position[i] / 32767.0f, -1.0f);
+            mesh.normals[v * 3 + i] = fmaxf(quantizedVertices[v].normal[i] / 32767.0f, -1.0f);
+        }
+        mesh.texcoords[v * 2] = HalfToFloat(quantizedVertices[v].texcoord[0]);
+        mesh.texcoords[v * 2 + 1] = HalfToFloat(quantizedVertices[v].texcoord[1]);
+    }
+}
+
+// Uploads one level of a validated cache blob straight from its memory, the model keeps no CPU-side vertex copy.
+// Under GL 1.1 there are no vertex buffers and DrawMesh draws from the CPU arrays, so there it keeps a copy.
+Model UploadMeshCache(const unsigned char* data, int lod = 0)
+{
+    const MeshCacheHeader* header = (const MeshCacheHeader*)data;
+    const MeshCacheLod& level = MeshCacheLods(data)[lod];
+    const MeshCacheSubmesh* table = MeshCacheSubmeshes(data) + level.firstSubmesh;
+    const bool quantized = (header->flags & MESH_CACHE_QUANTIZED) != 0;
+
+    Model model = { 0 };
+    model.transform = MatrixIdentity();
+    model.meshCount = (int)level.submeshCount;
+    model.meshes = (Mesh*)MemAlloc(sizeof(Mesh) * model.meshCount);
+    model.materialCount = 1;
+    model.materials = (Material*)MemAlloc(sizeof(Material));
+    model.materials[0] = LoadMaterialDefault();
+    model.meshMaterial = (int*)MemAlloc(sizeof(int) * model.meshCount);
+
+    // Quantized positions are relative to the quantisation frame, undo it in the model transform
+    if (quantized)
+    {
+        const float* center = header->quantizeCenter;
+        const float scale = header->quantizeScale;
+        model.transform = Multiply(Scale(scale, scale, scale), Translate(center[0], center[1], center[2]));
+    }
+
+    for (int s = 0; s < model.meshCount; s++)
+    {
+        const unsigned char* vertices = data + table[s].offset;
+        const size_t vertexBytes = quantized ? sizeof(QuantizedVertex) : (3 + 3 + 2) * sizeof(float);
+        Mesh& mesh = model.meshes[s];
+        mesh.vertexCount = (int)table[s].vertexCount;
+        mesh.triangleCount = (int)table[s].indexCount / 3;
+
+        // DrawMesh only issues an indexed draw while mesh.indices is set, so indices are the one array kept on the CPU
+        mesh.indices = (unsigned short*)MemAlloc(table[s].indexCount * sizeof(unsigned short));
+        memcpy(mesh.indices, vertices + mesh.vertexCount * vertexBytes, table[s].indexCount * sizeof(unsigned short));
+
+#if defined(GRAPHICS_API_OPENGL_11)
+        CopyMeshArrays(mesh, vertices, quantized);
+        UploadMesh(&mesh, false);
+        continue;
+#endif
+
+        if (quantized)
+        {
+#if defined(MESH_GL_QUANTIZED_ATTRIBUTES)
+            UploadQuantizedMesh(mesh, (const QuantizedVertex*)vertices);
+#else
+            CopyMeshArrays(mesh, vertices, true);
+            UploadMesh(&mesh, false);
+            MemFree(mesh.vertices);
+            MemFree(mesh.normals);
+            MemFree(mesh.texcoords);
+            mesh.vertices = nullptr;
+            mesh.normals = nullptr;
+            mesh.texcoords = nullptr;
+#endif
+            continue;
+        }
+
+        float* positions = (float*)vertices;
+        mesh.vertices = positions;
+        mesh.normals = positions + mesh.vertexCount * 3;
+        mesh.texcoords = mesh.normals + mesh.vertexCount * 3;
+        UploadMesh(&mesh, false);
+
+        // Vertex data belongs to the cache, not to raylib's allocator
+        mesh.vertices = nullptr;
+        mesh.normals = nullptr;
+        mesh.texcoords = nullptr;
+    }
+
+    return model;
+}
+
+bool SaveMeshCache(const char* fileName, const std::vector<unsigned char>& blob)
+{
+    // Write then rename so a crash never leaves a truncated cache behind
+    std::string tempName = std::string(fileName) + ".tmp";
+    std::ofstream outFile(tempName, std::ios::binary | std::ios::trunc);
+    outFile.write((const char*)blob.data(), blob.size());
+    outFile.close();
+    if (!outFile)
+    {
+        std::remove(tempName.c_str());
+        return false;
+    }
+
+    std::remove(fileName);
+    return std::rename(tempName.c_str(), fileName) == 0;
+}
+
+// Imports an OBJ into a cache blob: weld, level generation, ordering, layout
+bool ImportMeshCache(const char* fileName, long sourceModTime, const MeshImportOptions& options,
+    std::vector<unsigned char>& blob)
+{
+    double start = GetTime();
+    MeshData mesh;
+    if (!ImportObj(fileName, mesh)) return false;
+
+    std::vector<MeshData> lods;
+    std::vector<float> errors;
+    if (options.generateLods) GenerateLods(mesh, lods, errors);
+    else
+    {
+        lods.assign(1, mesh);
+        errors.assign(1, 0.0f);
+    }
+
+    for (size_t l = 0; l < lods.size(); l++)
+    {
+        VertexCacheStats before = AnalyzeVertexCache(lods[l].indices, lods[l].vertices.size());
+        if (options.optimize) OptimizeMesh(lods[l]);
+        VertexCacheStats after = AnalyzeVertexCache(lods[l].indices, lods[l].vertices.size());
+
+        TraceLog(LOG_INFO, "MESH: [%s] LOD %i: %i vertices, %i triangles, error %.4f, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+            fileName, (int)l, (int)lods[l].vertices.size(), (int)lods[l].indices.size() / 3, errors[l],
+            before.acmr, after.acmr, before.atvr, after.atvr);
+    }
+
+    uint32_t flags = MeshCacheFlags(options);
+    blob = SerializeMesh(lods, errors, sourceModTime, flags);
+    TraceLog(LOG_INFO, "MESH: [%s] Imported in %.2f ms, %i bytes per vertex", fileName, (GetTime() - start) * 1000.0,
+        options.quantize ? (int)sizeof(QuantizedVertex) : (int)((3 + 3 + 2) * sizeof(float)));
+
+    return true;
+}
+
+// Opens <fileName>.mesh, importing and rewriting it when it is missing, stale or was written with different
+// options. On success blob or cache holds valid cache data (cache takes precedence), release both afterwards.
+// Mod times are whole seconds, so reimport skips the cache for sources known to have changed since.
+bool AcquireMeshCache(const char* fileName, const MeshImportOptions& options,
+    AssetFile& cache, std::vector<unsigned char>& blob, bool reimport = false)
+{
+    std::string cacheName = std::string(fileName) + MESH_CACHE_EXTENSION;
+    long sourceModTime = GetAssetFileModTime(fileName);
+    uint32_t flags = MeshCacheFlags(options);
+
+    if (!reimport)
+    {
+        cache = LoadAssetFile(cacheName.c_str());
+        if (ValidateMeshCache(cache.data, cache.size, sourceModTime, flags)) return true;
+        UnloadAssetFile(cache);
+    }
+
+    if (!ImportMeshCache(fileName, sourceModTime, options, blob)) return false;
+
+    if (!SaveMeshCache(cacheName.c_str(), blob))
+        TraceLog(LOG_WARNING, "MESH: [%s] Failed to write mesh cache", cacheName.c_str());
+
+    return true;
+}
+
+// Loads an OBJ through its binary cache (<fileName>.mesh), importing and writing the cache when it is missing,
+// stale or was written with different options
+Model LoadModelCached(const char* fileName, const MeshImportOptions& options = MeshImportOptions())
+{
+    AssetFile cache;
+    std::vector<unsigned char> blob;
+    if (!AcquireMeshCache(fileName, options, cache, blob)) return LoadModel(fileName);
+
+    Model model = UploadMeshCache(cache.data != nullptr ? cache.data : blob.data());
+    UnloadAssetFile(cache);
+    return model;
+}
+
+// Uploads every level of a validated cache, must run on the thread owning the GL context
+LodModel UploadLodModel(const unsigned char* data)
+{
+    LodModel model;
+    const MeshCacheHeader* header = (const MeshCacheHeader*)data;
+    for (uint32_t l = 0; l < header->lodCount; l++)
+    {
+        model.lods.push_back(UploadMeshCache(data, (int)l));
+        model.errors.push_back(MeshCacheLods(data)[l].error);
+    }
+
+    Vector3 boundsMin = { header->boundsMin[0], header->boundsMin[1], header->boundsMin[2] };
+    Vector3 boundsMax = { header->boundsMax[0], header->boundsMax[1], header->boundsMax[2] };
+    model.center = (boundsMin + boundsMax) * 0.5f;
+    model.radius = Distance(boundsMin, boundsMax) * 0.5f;
+    return model;
+}
+
+// Loads every level of an OBJ through its binary cache
+LodModel LoadLodModelCached(const char* fileName, const MeshImportOptions& options = MeshImportOptions())
+{
+    LodModel model;
+    AssetFile cache;
+    std::vector<unsigned char> blob;
+    if (!AcquireMeshCache(fileName, options, cache, blob))
+    {
+        model.lods.push_back(LoadModel(fileName));
+        model.errors.push_back(0.0f);
+        return model;
+    }
+
+    model = UploadLodModel(cache.data != nullptr ? cache.data : blob.data());
+    UnloadAssetFile(cache);
+    return model;
+}
+
+void UnloadLodModel(LodModel& model)
+{
+    for (Model& lod : model.lods)
+        UnloadModel(lod);
+    model = LodModel();
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+struct MeshVertex
+{
+    Vector3 position;
+    Vector3 normal;
+    Vector2 texcoord;
+};
+
+// Indexed triangle mesh produced by the importer
+struct MeshData
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    Vector3 boundsMin{ 0.0f, 0.0f, 0.0f };
+    Vector3 boundsMax{ 0.0f, 0.0f, 0.0f };
+};
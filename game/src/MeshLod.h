@@ -0,0 +1,368 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "MeshData.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+// Border edges get a perpendicular constraint plane this much heavier than surface planes,
+// which keeps open silhouettes (wing tips, cockpit rims) from collapsing inward
+#define LOD_BORDER_WEIGHT 10.0
+
+// Each level targets this fraction of the previous level's triangles
+#define LOD_REDUCTION 0.5f
+
+// Stop the chain once a level would have fewer triangles than this
+#define LOD_MIN_TRIANGLES 32
+
+#define LOD_MAX_LEVELS 5
+
+// Symmetric 4x4 error quadric for plane-distance sums (Garland & Heckbert)
+struct Quadric
+{
+    double a2, ab, ac, ad;
+    double b2, bc, bd;
+    double c2, cd;
+    double d2;
+    double weight;
+};
+
+Quadric PlaneQuadric(double a, double b, double c, double d, double weight)
+{
+    Quadric q;
+    q.a2 = a * a * weight; q.ab = a * b * weight; q.ac = a * c * weight; q.ad = a * d * weight;
+    q.b2 = b * b * weight; q.bc = b * c * weight; q.bd = b * d * weight;
+    q.c2 = c * c * weight; q.cd = c * d * weight;
+    q.d2 = d * d * weight;
+    q.weight = weight;
+    return q;
+}
+
+void AddQuadric(Quadric& q, const Quadric& other)
+{
+    q.a2 += other.a2; q.ab += other.ab; q.ac += other.ac; q.ad += other.ad;
+    q.b2 += other.b2; q.bc += other.bc; q.bd += other.bd;
+    q.c2 += other.c2; q.cd += other.cd;
+    q.d2 += other.d2;
+    q.weight += other.weight;
+}
+
+// Weighted mean squared distance from p to the quadric's planes
+double QuadricError(const Quadric& q, Vector3 p)
+{
+    double x = p.x, y = p.y, z = p.z;
+    double error =
+        q.a2 * x * x + 2.0 * q.ab * x * y + 2.0 * q.ac * x * z + 2.0 * q.ad * x +
+        q.b2 * y * y + 2.0 * q.bc * y * z + 2.0 * q.bd * y +
+        q.c2 * z * z + 2.0 * q.cd * z +
+        q.d2;
+    return q.weight > 0.0 ? fabs(error) / q.weight : 0.0;
+}
+
+Quadric TriangleQuadric(Vector3 p0, Vector3 p1, Vector3 p2, double weight)
+{
+    Vector3 normal = Cross(p1 - p0, p2 - p0);
+    float length = Length(normal);
+    if (length <= 0.0f) return PlaneQuadric(0.0, 0.0, 0.0, 0.0, 0.0);
+
+    normal = normal / length;
+    return PlaneQuadric(normal.x, normal.y, normal.z, -Dot(normal, p0), weight);
+}
+
+// Simplifies the mesh by half-edge collapses in position space until at most targetTriangles remain
+// or nothing can be collapsed without flipping a triangle. Collapsed corners keep their own normal and
+// texcoord, so seams and flat-shaded faces survive. Returns the largest deviation introduced, in mesh units.
+float SimplifyMesh(const MeshData& mesh, size_t targetTriangles, MeshData& result)
+{
+    // Weld by position: topology has to come from positions, the importer keeps one vertex per attribute corner
+    struct PositionKey
+    {
+        uint32_t x, y, z;
+        bool operator==(const PositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+    };
+    struct PositionKeyHash
+    {
+        size_t operator()(const PositionKey& k) const
+        {
+            return (size_t)(((uint64_t)k.x * 0x9E3779B97F4A7C15ull) ^ ((uint64_t)k.y * 0xC2B2AE3D27D4EB4Full) ^ ((uint64_t)k.z * 0x165667B19E3779F9ull));
+        }
+    };
+
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> welded;
+    std::vector<uint32_t> positionOf(mesh.vertices.size());
+    std::vector<Vector3> positions;
+    for (size_t v = 0; v < mesh.vertices.size(); v++)
+    {
+        PositionKey key;
+        memcpy(&key, &mesh.vertices[v].position, sizeof(key));
+        auto inserted = welded.insert({ key, (uint32_t)positions.size() });
+        if (inserted.second) positions.push_back(mesh.vertices[v].position);
+        positionOf[v] = inserted.first->second;
+    }
+
+    struct Triangle
+    {
+        uint32_t p[3];      // welded positions
+        uint32_t w[3];      // source vertices, for attributes
+        bool alive;
+    };
+
+    std::vector<Triangle> triangles;
+    triangles.reserve(mesh.indices.size() / 3);
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+    {
+        Triangle t;
+        for (int j = 0; j < 3; j++)
+        {
+            t.w[j] = mesh.indices[i + j];
+            t.p[j] = positionOf[t.w[j]];
+        }
+        t.alive = t.p[0] != t.p[1] && t.p[1] != t.p[2] && t.p[2] != t.p[0];
+        if (t.alive) triangles.push_back(t);
+    }
+
+    std::vector<Quadric> quadrics(positions.size(), PlaneQuadric(0.0, 0.0, 0.0, 0.0, 0.0));
+    std::vector<std::vector<uint32_t>> adjacent(positions.size());
+    std::unordered_map<uint64_t, int> edgeUse;
+    for (uint32_t t = 0; t < triangles.size(); t++)
+    {
+        const Triangle& tri = triangles[t];
+        Vector3 p0 = positions[tri.p[0]], p1 = positions[tri.p[1]], p2 = positions[tri.p[2]];
+        Quadric q = TriangleQuadric(p0, p1, p2, 0.5 * Length(Cross(p1 - p0, p2 - p0)));
+        for (int j = 0; j < 3; j++)
+        {
+            AddQuadric(quadrics[tri.p[j]], q);
+            adjacent[tri.p[j]].push_back(t);
+
+            uint32_t a = std::min(tri.p[j], tri.p[(j + 1) % 3]);
+            uint32_t b = std::max(tri.p[j], tri.p[(j + 1) % 3]);
+            edgeUse[((uint64_t)a << 32) | b]++;
+        }
+    }
+
+    // Constraint planes through border edges, perpendicular to their triangle
+    for (const Triangle& tri : triangles)
+    {
+        Vector3 p0 = positions[tri.p[0]], p1 = positions[tri.p[1]], p2 = positions[tri.p[2]];
+        Vector3 normal = Normalize(Cross(p1 - p0, p2 - p0));
+        for (int j = 0; j < 3; j++)
+        {
+            uint32_t a = tri.p[j], b = tri.p[(j + 1) % 3];
+            if (edgeUse[((uint64_t)std::min(a, b) << 32) | std::max(a, b)] != 1) continue;
+
+            Vector3 edge = positions[b] - positions[a];
+            Vector3 side = Normalize(Cross(edge, normal));
+            double weight = LOD_BORDER_WEIGHT * LengthSqr(edge);
+            Quadric q = PlaneQuadric(side.x, side.y, side.z, -Dot(side, positions[a]), weight);
+            AddQuadric(quadrics[a], q);
+            AddQuadric(quadrics[b], q);
+        }
+    }
+
+    struct Collapse
+    {
+        double cost;
+        uint32_t from, to;
+        uint32_t fromStamp, toStamp;
+        bool operator<(const Collapse& o) const { return cost > o.cost; }
+    };
+
+    std::vector<uint32_t> stamp(positions.size(), 0);
+    std::vector<bool> removed(positions.size(), false);
+    std::priority_queue<Collapse> queue;
+
+    auto pushCollapses = [&](uint32_t a, uint32_t b)
+    {
+        Quadric q = quadrics[a];
+        AddQuadric(q, quadrics[b]);
+        queue.push({ QuadricError(q, positions[b]), a, b, stamp[a], stamp[b] });
+        queue.push({ QuadricError(q, positions[a]), b, a, stamp[b], stamp[a] });
+    };
+
+    for (const Triangle& tri : triangles)
+    {
+        for (int j = 0; j < 3; j++)
+            pushCollapses(tri.p[j], tri.p[(j + 1) % 3]);
+    }
+
+    size_t aliveTriangles = triangles.size();
+    double maxError = 0.0;
+    std::vector<uint32_t> neighbours;
+    while (aliveTriangles > targetTriangles && !queue.empty())
+    {
+        Collapse collapse = queue.top();
+        queue.pop();
+
+        uint32_t u = collapse.from, v = collapse.to;
+        if (removed[u] || removed[v] || stamp[u] != collapse.fromStamp || stamp[v] != collapse.toStamp) continue;
+
+        // Reject collapses that flip or degenerate any surviving triangle around u
+        bool valid = true;
+        for (uint32_t t : adjacent[u])
+        {
+            const Triangle& tri = triangles[t];
+            if (!tri.alive || tri.p[0] == v || tri.p[1] == v || tri.p[2] == v) continue;
+
+            Vector3 before[3], after[3];
+            for (int j = 0; j < 3; j++)
+            {
+                before[j] = positions[tri.p[j]];
+                after[j] = tri.p[j] == u ? positions[v] : before[j];
+            }
+            Vector3 n0 = Cross(before[1] - before[0], before[2] - before[0]);
+            Vector3 n1 = Cross(after[1] - after[0], after[2] - after[0]);
+            if (Dot(n0, n1) <= 0.25f * Length(n0) * Length(n1))
+            {
+                valid = false;
+                break;
+            }
+        }
+        if (!valid) continue;
+
+        for (uint32_t t : adjacent[u])
+        {
+            Triangle& tri = triangles[t];
+            if (!tri.alive) continue;
+
+            if (tri.p[0] == v || tri.p[1] == v || tri.p[2] == v)
+            {
+                tri.alive = false;
+                aliveTriangles--;
+                continue;
+            }
+
+            for (int j = 0; j < 3; j++)
+            {
+                if (tri.p[j] == u) tri.p[j] = v;
+            }
+            adjacent[v].push_back(t);
+        }
+
+        removed[u] = true;
+        adjacent[u].clear();
+        AddQuadric(quadrics[v], quadrics[u]);
+        maxError = std::max(maxError, collapse.cost);
+
+        // Drop dead triangles from v's list and requeue its edges with the merged quadric
+        stamp[v]++;
+        neighbours.clear();
+        std::vector<uint32_t>& list = adjacent[v];
+        list.erase(std::remove_if(list.begin(), list.end(),
+            [&triangles](uint32_t t) { return !triangles[t].alive; }), list.end());
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        for (uint32_t t : list)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                if (triangles[t].p[j] != v) neighbours.push_back(triangles[t].p[j]);
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (uint32_t w : neighbours)
+            pushCollapses(v, w);
+    }
+
+    // Surviving corners become (position, source attributes) vertices
+    std::unordered_map<uint64_t, uint32_t> corners;
+    result.vertices.clear();
+    result.indices.clear();
+    for (const Triangle& tri : triangles)
+    {
+        if (!tri.alive) continue;
+
+        for (int j = 0; j < 3; j++)
+        {
+            uint64_t key = ((uint64_t)tri.p[j] << 32) | tri.w[j];
+            auto inserted = corners.insert({ key, (uint32_t)result.vertices.size() });
+            if (inserted.second)
+            {
+                MeshVertex vertex = mesh.vertices[tri.w[j]];
+                vertex.position = positions[tri.p[j]];
+                result.vertices.push_back(vertex);
+            }
+            result.indices.push_back(inserted.first->second);
+        }
+    }
+    result.boundsMin = mesh.boundsMin;
+    result.boundsMax = mesh.boundsMax;
+
+    return (float)sqrt(maxError);
+}
+
+// Builds successively coarser levels from the full mesh. lods[0] is the input, errors[0] is 0.
+void GenerateLods(const MeshData& mesh, std::vector<MeshData>& lods, std::vector<float>& errors)
+{
+    lods.assign(1, mesh);
+    errors.assign(1, 0.0f);
+
+    size_t triangleCount = mesh.indices.size() / 3;
+    while (lods.size() < LOD_MAX_LEVELS)
+    {
+        size_t target = (size_t)(triangleCount * LOD_REDUCTION);
+        if (target < LOD_MIN_TRIANGLES) break;
+
+        // Simplify from the full mesh each time so errors are measured against the original
+        MeshData lod;
+        float error = SimplifyMesh(mesh, target, lod);
+        size_t simplified = lod.indices.size() / 3;
+
+        // Stuck on flips or borders, further levels would only duplicate this one
+        if (simplified > triangleCount * (LOD_REDUCTION + 1.0f) * 0.5f) break;
+
+        errors.push_back(std::max(error, errors.back()));
+        lods.push_back(std::move(lod));
+        triangleCount = simplified;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Runtime selection
+//----------------------------------------------------------------------------------
+
+// All levels of one model, finest first
+struct LodModel
+{
+    std::vector<Model> lods;
+    std::vector<float> errors;      // object-space deviation of each level from lods[0]
+    Vector3 center{ 0.0f, 0.0f, 0.0f };
+    float radius = 0.0f;            // object-space bounding sphere
+};
+
+// Projected size in pixels of an object-space length at the model's bounding sphere,
+// FLT_MAX when the camera is inside the sphere
+float ProjectedSize(const LodModel& model, float length, Matrix transform, Matrix view, Matrix projection, int screenHeight)
+{
+    // Largest axis scale of the transform, so scaled instances stay conservative
+    float scale = sqrtf(fmaxf(transform.m0 * transform.m0 + transform.m1 * transform.m1 + transform.m2 * transform.m2,
+        fmaxf(transform.m4 * transform.m4 + transform.m5 * transform.m5 + transform.m6 * transform.m6,
+            transform.m8 * transform.m8 + transform.m9 * transform.m9 + transform.m10 * transform.m10)));
+
+    Vector3 viewCenter = Multiply(Multiply(model.center, transform), view);
+    float depth = -viewCenter.z - model.radius * scale;
+    if (depth <= 0.0f) return FLT_MAX;
+
+    // m5 is cot(fovy / 2): NDC units per view unit at depth 1
+    return length * scale * projection.m5 / depth * screenHeight * 0.5f;
+}
+
+// Coarsest level whose deviation projects to at most maxPixelError pixels
+int SelectLod(const LodModel& model, Matrix transform, Matrix view, Matrix projection, int screenHeight,
+    float maxPixelError = 1.0f)
+{
+    int lod = 0;
+    for (int i = 1; i < (int)model.lods.size(); i++)
+    {
+        float pixels = ProjectedSize(model, model.errors[i], transform, view, projection, screenHeight);
+        if (pixels > maxPixelError) break;
+        lod = i;
+    }
+    return lod;
+}
@@ -0,0 +1,402 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "MeshData.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Post-transform cache size the triangle order is tuned for (LRU)
+#define VERTEX_CACHE_OPTIMIZE_SIZE 32
+
+// Cache size used for reported statistics, a FIFO of 16 approximates most desktop GPUs
+#define VERTEX_CACHE_STATS_SIZE 16
+
+// Overdraw reordering is kept only if ACMR grows by less than this factor
+#define OVERDRAW_ACMR_THRESHOLD 1.05f
+
+struct VertexCacheStats
+{
+    float acmr;     // average cache miss ratio, vertex transforms per triangle (0.5 ideal, 3.0 worst)
+    float atvr;     // average transform to vertex ratio, vertex transforms per vertex (1.0 ideal)
+};
+
+// Simulates a FIFO post-transform cache over the index list
+VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+    int cacheSize = VERTEX_CACHE_STATS_SIZE)
+{
+    VertexCacheStats stats{ 0.0f, 0.0f };
+    if (indices.size() < 3 || vertexCount == 0) return stats;
+
+    // A vertex is cached while fewer than cacheSize misses happened since it was loaded
+    std::vector<uint32_t> loadedAt(vertexCount, 0);
+    uint32_t misses = 0;
+    for (uint32_t index : indices)
+    {
+        if (loadedAt[index] == 0 || misses - loadedAt[index] >= (uint32_t)cacheSize)
+        {
+            misses++;
+            loadedAt[index] = misses;
+        }
+    }
+
+    stats.acmr = (float)misses / (float)(indices.size() / 3);
+    stats.atvr = (float)misses / (float)vertexCount;
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Triangle order (Tom Forsyth, "Linear-Speed Vertex Cache Optimisation")
+//----------------------------------------------------------------------------------
+
+float ForsythVertexScore(int cachePosition, uint32_t remainingTriangles)
+{
+    if (remainingTriangles == 0) return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        // The last triangle's vertices score a fixed amount so the next triangle doesn't just reuse them
+        if (cachePosition < 3) score = 0.75f;
+        else
+        {
+            float scale = 1.0f / (VERTEX_CACHE_OPTIMIZE_SIZE - 3);
+            score = powf(1.0f - (cachePosition - 3) * scale, 1.5f);
+        }
+    }
+
+    // Favour vertices with few triangles left, so they get finished and leave the cache
+    return score + 2.0f * powf((float)remainingTriangles, -0.5f);
+}
+
+// Reorders triangles so consecutive triangles share recently transformed vertices
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Vertex -> triangle adjacency in CSR form
+    std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+    for (uint32_t index : indices)
+        adjacencyStart[index + 1]++;
+    for (size_t v = 0; v < vertexCount; v++)
+        adjacencyStart[v + 1] += adjacencyStart[v];
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        for (size_t j = 0; j < 3; j++)
+        {
+            uint32_t v = indices[t * 3 + j];
+            adjacency[adjacencyStart[v] + remaining[v]++] = (uint32_t)t;
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+        vertexScore[v] = ForsythVertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; t++)
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+    std::vector<uint32_t> cache, nextCache;
+    cache.reserve(VERTEX_CACHE_OPTIMIZE_SIZE + 3);
+    nextCache.reserve(VERTEX_CACHE_OPTIMIZE_SIZE + 3);
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    size_t scanCursor = 0;
+    int64_t best = -1;
+    float bestScore = -1.0f;
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        if (triangleScore[t] > bestScore)
+        {
+            bestScore = triangleScore[t];
+            best = (int64_t)t;
+        }
+    }
+
+    while (best >= 0)
+    {
+        const uint32_t* triangle = &indices[best * 3];
+        emitted[best] = true;
+        result.insert(result.end(), triangle, triangle + 3);
+
+        // Retire the triangle from its vertices' adjacency lists
+        for (size_t j = 0; j < 3; j++)
+        {
+            uint32_t v = triangle[j];
+            uint32_t* list = &adjacency[adjacencyStart[v]];
+            uint32_t* last = list + remaining[v] - 1;
+            std::swap(*std::find(list, last + 1, (uint32_t)best), *last);
+            remaining[v]--;
+        }
+
+        // Triangle's vertices move to the front of the LRU cache
+        nextCache.assign(triangle, triangle + 3);
+        for (uint32_t v : cache)
+        {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                nextCache.push_back(v);
+        }
+        std::swap(cache, nextCache);
+
+        for (size_t i = 0; i < cache.size(); i++)
+        {
+            uint32_t v = cache[i];
+            cachePosition[v] = i < VERTEX_CACHE_OPTIMIZE_SIZE ? (int)i : -1;
+            vertexScore[v] = ForsythVertexScore(cachePosition[v], remaining[v]);
+        }
+
+        // Only triangles touching the cache changed score, pick the best of those
+        best = -1;
+        bestScore = -1.0f;
+        for (uint32_t v : cache)
+        {
+            for (uint32_t a = 0; a < remaining[v]; a++)
+            {
+                uint32_t t = adjacency[adjacencyStart[v] + a];
+                float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+                triangleScore[t] = score;
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+        if (cache.size() > VERTEX_CACHE_OPTIMIZE_SIZE) cache.resize(VERTEX_CACHE_OPTIMIZE_SIZE);
+
+        // Cache ran dry (disconnected piece finished), continue with the next unused triangle
+        if (best < 0)
+        {
+            while (scanCursor < triangleCount && emitted[scanCursor]) scanCursor++;
+            if (scanCursor < triangleCount) best = (int64_t)scanCursor;
+        }
+    }
+
+    indices.swap(result);
+}
+
+//----------------------------------------------------------------------------------
+// Overdraw (Sander, Nehab & Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw")
+//----------------------------------------------------------------------------------
+
+// Splits the cache-optimised order into clusters at cache flushes and sorts clusters so
+// outward-facing ones draw first and occlude the rest. Keeps the result only if ACMR stays within threshold.
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshVertex>& vertices)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) return;
+
+    const VertexCacheStats before = AnalyzeVertexCache(indices, vertices.size());
+
+    // A triangle that misses on all three vertices starts a new cluster
+    std::vector<size_t> clusterStart;
+    std::vector<uint32_t> loadedAt(vertices.size(), 0);
+    uint32_t misses = 0;
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        int triangleMisses = 0;
+        for (size_t j = 0; j < 3; j++)
+        {
+            uint32_t index = indices[t * 3 + j];
+            if (loadedAt[index] == 0 || misses - loadedAt[index] >= VERTEX_CACHE_STATS_SIZE)
+            {
+                misses++;
+                loadedAt[index] = misses;
+                triangleMisses++;
+            }
+        }
+        if (t == 0 || triangleMisses == 3) clusterStart.push_back(t);
+    }
+    clusterStart.push_back(triangleCount);
+
+    const size_t clusterCount = clusterStart.size() - 1;
+    if (clusterCount < 2) return;
+
+    Vector3 meshCentroid = Vector3Zero();
+    for (const MeshVertex& vertex : vertices)
+        meshCentroid = meshCentroid + vertex.position;
+    meshCentroid = meshCentroid / (float)vertices.size();
+
+    // Sort key: how far the cluster faces away from the mesh centre
+    std::vector<float> clusterSortKey(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        Vector3 centroid = Vector3Zero();
+        Vector3 normal = Vector3Zero();
+        float area = 0.0f;
+        for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; t++)
+        {
+            Vector3 a = vertices[indices[t * 3]].position;
+            Vector3 b = vertices[indices[t * 3 + 1]].position;
+            Vector3 d = vertices[indices[t * 3 + 2]].position;
+            Vector3 areaNormal = Cross(b - a, d - a);
+            float triangleArea = Length(areaNormal);
+            centroid = centroid + (a + b + d) * (triangleArea / 3.0f);
+            normal = normal + areaNormal;
+            area += triangleArea;
+        }
+        centroid = area > 0.0f ? centroid / area : vertices[indices[clusterStart[c] * 3]].position;
+        clusterSortKey[c] = Dot(centroid - meshCentroid, Normalize(normal));
+    }
+
+    std::vector<uint32_t> clusterOrder(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++)
+        clusterOrder[c] = (uint32_t)c;
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(),
+        [&clusterSortKey](uint32_t a, uint32_t b) { return clusterSortKey[a] > clusterSortKey[b]; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (uint32_t c : clusterOrder)
+        result.insert(result.end(), indices.begin() + clusterStart[c] * 3, indices.begin() + clusterStart[c + 1] * 3);
+
+    const VertexCacheStats after = AnalyzeVertexCache(result, vertices.size());
+    if (after.acmr <= before.acmr * OVERDRAW_ACMR_THRESHOLD)
+        indices.swap(result);
+}
+
+//----------------------------------------------------------------------------------
+// Vertex order
+//----------------------------------------------------------------------------------
+
+// Renumbers vertices in order of first use so the vertex fetch walks memory linearly,
+// unreferenced vertices are dropped
+void OptimizeVertexFetch(MeshData& mesh)
+{
+    const uint32_t unused = ~0u;
+    std::vector<uint32_t> remap(mesh.vertices.size(), unused);
+    std::vector<MeshVertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+
+    for (uint32_t& index : mesh.indices)
+    {
+        if (remap[index] == unused)
+        {
+            remap[index] = (uint32_t)vertices.size();
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    mesh.vertices.swap(vertices);
+}
+
+// Full import-time pass: triangle order for the post-transform cache and overdraw, then vertex order for fetch
+void OptimizeMesh(MeshData& mesh)
+{
+    OptimizeVertexCache(mesh.indices, mesh.vertices.size());
+    OptimizeOverdraw(mesh.indices, mesh.vertices);
+    OptimizeVertexFetch(mesh);
+}
+
+//----------------------------------------------------------------------------------
+// Attribute quantisation
+//----------------------------------------------------------------------------------
+
+// Map [-1, 1] to a normalized signed 16-bit integer
+int16_t QuantizeSnorm16(float value)
+{
+    value = Clamp(value, -1.0f, 1.0f) * 32767.0f;
+    return (int16_t)(value >= 0.0f ? value + 0.5f : value - 0.5f);
+}
+
+// IEEE 754 binary16, round to nearest even, overflow saturates to infinity
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000;
+    int32_t exponent = (int32_t)((bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (((bits >> 23) & 0xFF) == 0xFF) return (uint16_t)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+    if (exponent >= 31) return (uint16_t)(sign | 0x7C00);
+    if (exponent <= 0)
+    {
+        // Subnormal half or zero
+        if (exponent < -10) return (uint16_t)sign;
+        mantissa |= 0x800000;
+        uint32_t shift = (uint32_t)(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1))) half++;
+        return (uint16_t)(sign | half);
+    }
+
+    uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) half++;
+    return (uint16_t)half;
+}
+
+// Inverse of FloatToHalf
+float HalfToFloat(uint16_t half)
+{
+    const uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0x1F) bits = sign | 0x7F800000 | (mantissa << 13);
+    else if (exponent != 0) bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    else if (mantissa == 0) bits = sign;
+    else
+    {
+        // Subnormal half, normal as a float
+        exponent = 127 - 15 + 1;
+        while (!(mantissa & 0x400))
+        {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+    }
+
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 16-byte vertex: position snorm16 relative to the quantisation frame, normal snorm16, texcoord half
+struct QuantizedVertex
+{
+    int16_t position[3];
+    int16_t normal[3];
+    uint16_t texcoord[2];
+};
+
+// Uniform frame so normals need no correction: position = center + quantized * scale
+void QuantizationFrame(const MeshData& mesh, Vector3& center, float& scale)
+{
+    center = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+    Vector3 extent = (mesh.boundsMax - mesh.boundsMin) * 0.5f;
+    scale = fmaxf(extent.x, fmaxf(extent.y, extent.z));
+    if (scale <= 0.0f) scale = 1.0f;
+}
+
+QuantizedVertex QuantizeVertex(const MeshVertex& vertex, Vector3 center, float scale)
+{
+    QuantizedVertex result;
+    Vector3 position = (vertex.position - center) / scale;
+    result.position[0] = QuantizeSnorm16(position.x);
+    result.position[1] = QuantizeSnorm16(position.y);
+    result.position[2] = QuantizeSnorm16(position.z);
+    result.normal[0] = QuantizeSnorm16(vertex.normal.x);
+    result.normal[1] = QuantizeSnorm16(vertex.normal.y);
+    result.normal[2] = QuantizeSnorm16(vertex.normal.z);
+    result.texcoord[0] = FloatToHalf(vertex.texcoord.x);
+    result.texcoord[1] = FloatToHalf(vertex.texcoord.y);
+    return result;
+}
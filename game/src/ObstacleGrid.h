@@ -0,0 +1,580 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "Collision.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// World units per grid cell, roughly the size of a typical obstacle
+#define OBSTACLE_GRID_CELL_SIZE 64.0f
+
+// Steps per cell of the 16-bit cell-relative coordinates in each cell's compact boxes
+#define OBSTACLE_GRID_COMPACT_STEPS 65535.0f
+
+// Interleaves the low 16 bits of x and y into a Z-order curve index
+uint32_t MortonCode(uint32_t x, uint32_t y)
+{
+    auto spread = [](uint32_t v)
+    {
+        v &= 0xffff;
+        v = (v | (v << 8)) & 0x00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+// Obstacle bounds relative to a cell's origin, clipped to the cell and rounded outwards so a
+// compact box always contains the part of the obstacle inside the cell
+struct CompactBox
+{
+    uint16_t x0, y0, x1, y1;
+};
+
+struct ObstacleDistance
+{
+    int id;
+    float distanceSqr;  // from the query point to the nearest point of the obstacle
+};
+
+// Sparse uniform grid over obstacle rectangles. Each obstacle is listed in every cell it overlaps, so inserts
+// and removals only touch those cells and never rebuild the grid. Cells also hold a compact box per obstacle,
+// half the size of a Rectangle, which overlap queries scan before touching any float geometry.
+class ObstacleGrid
+{
+public:
+    explicit ObstacleGrid(float cellSize = OBSTACLE_GRID_CELL_SIZE)
+        : mCellSize(cellSize), mInvCellSize(1.0f / cellSize), mCompactScale(OBSTACLE_GRID_COMPACT_STEPS / cellSize)
+    {
+    }
+
+    // Returns a stable id, valid until the obstacle is removed
+    int Insert(Rectangle rectangle)
+    {
+        int id;
+        if (mFreeIds.empty())
+        {
+            id = (int)mSlots.size();
+            mSlots.push_back(-1);
+        }
+        else
+        {
+            id = mFreeIds.back();
+            mFreeIds.pop_back();
+        }
+
+        mSlots[id] = (int)mRectangles.size();
+        mRectangles.push_back(rectangle);
+        mIds.push_back(id);
+
+        int x0, y0, x1, y1;
+        CellRange(rectangle, x0, y0, x1, y1);
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                GridCell& cell = mCells[CellKey(x, y)];
+                cell.ids.push_back(id);
+                cell.boxes.push_back(Compact(rectangle, x, y));
+            }
+        }
+
+        // Only grows, good enough to bound searches
+        mMinX = std::min(mMinX, x0);
+        mMinY = std::min(mMinY, y0);
+        mMaxX = std::max(mMaxX, x1);
+        mMaxY = std::max(mMaxY, y1);
+        mVersion++;
+        return id;
+    }
+
+    bool Remove(int id)
+    {
+        if (!Contains(id)) return false;
+
+        const int slot = mSlots[id];
+        int x0, y0, x1, y1;
+        CellRange(mRectangles[slot], x0, y0, x1, y1);
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                auto cell = mCells.find(CellKey(x, y));
+                GridCell& entries = cell->second;
+                const size_t index = std::find(entries.ids.begin(), entries.ids.end(), id) - entries.ids.begin();
+                entries.ids.erase(entries.ids.begin() + index);
+                entries.boxes.erase(entries.boxes.begin() + index);
+                if (entries.ids.empty()) mCells.erase(cell);
+            }
+        }
+
+        // Swap the last obstacle into the hole so Rectangles() stays dense
+        const int last = (int)mRectangles.size() - 1;
+        mRectangles[slot] = mRectangles[last];
+        mIds[slot] = mIds[last];
+        mSlots[mIds[slot]] = slot;
+        mRectangles.pop_back();
+        mIds.pop_back();
+
+        mSlots[id] = -1;
+        mFreeIds.push_back(id);
+        mVersion++;
+        return true;
+    }
+
+    // Removes one obstacle exactly equal to rectangle
+    bool Remove(Rectangle rectangle)
+    {
+        auto cell = mCells.find(CellKey(CellCoord(rectangle.x), CellCoord(rectangle.y)));
+        if (cell == mCells.end()) return false;
+
+        for (int id : cell->second.ids)
+        {
+            const Rectangle& candidate = mRectangles[mSlots[id]];
+            if (candidate.x == rectangle.x && candidate.y == rectangle.y &&
+                candidate.width == rectangle.width && candidate.height == rectangle.height)
+                return Remove(id);
+        }
+        return false;
+    }
+
+    void Clear()
+    {
+        mCells.clear();
+        mRectangles.clear();
+        mIds.clear();
+        mSlots.clear();
+        mFreeIds.clear();
+        mMinX = mMinY = INT_MAX;
+        mMaxX = mMaxY = INT_MIN;
+        mVersion++;
+    }
+
+    bool Contains(int id) const
+    {
+        return id >= 0 && id < (int)mSlots.size() && mSlots[id] >= 0;
+    }
+
+    const Rectangle& Get(int id) const
+    {
+        return mRectangles[mSlots[id]];
+    }
+
+    size_t Count() const
+    {
+        return mRectangles.size();
+    }
+
+    // Live obstacles in no particular order, Ids() holds the id of each
+    const std::vector<Rectangle>& Rectangles() const
+    {
+        return mRectangles;
+    }
+
+    const std::vector<int>& Ids() const
+    {
+        return mIds;
+    }
+
+    float CellSize() const
+    {
+        return mCellSize;
+    }
+
+    // Bumped by every insert, removal and clear so cached queries can tell when they're stale
+    unsigned int Version() const
+    {
+        return mVersion;
+    }
+
+    // Reorders storage along a Z-order curve through the obstacle centres so neighbours sit next to each other
+    // in memory, and each cell lists its ids in storage order. Ids don't change, only where they're stored.
+    void SortByMorton()
+    {
+        const size_t count = mRectangles.size();
+        if (count < 2) return;
+
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+        for (const Rectangle& r : mRectangles)
+        {
+            minX = std::min(minX, r.x + r.width * 0.5f);
+            minY = std::min(minY, r.y + r.height * 0.5f);
+            maxX = std::max(maxX, r.x + r.width * 0.5f);
+            maxY = std::max(maxY, r.y + r.height * 0.5f);
+        }
+        const float scaleX = maxX > minX ? 65535.0f / (maxX - minX) : 0.0f;
+        const float scaleY = maxY > minY ? 65535.0f / (maxY - minY) : 0.0f;
+
+        std::vector<std::pair<uint32_t, int>> order(count);
+        for (size_t slot = 0; slot < count; slot++)
+        {
+            const Rectangle& r = mRectangles[slot];
+            const uint32_t x = (uint32_t)((r.x + r.width * 0.5f - minX) * scaleX);
+            const uint32_t y = (uint32_t)((r.y + r.height * 0.5f - minY) * scaleY);
+            order[slot] = { MortonCode(x, y), (int)slot };
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<Rectangle> rectangles(count);
+        std::vector<int> ids(count);
+        for (size_t slot = 0; slot < count; slot++)
+        {
+            rectangles[slot] = mRectangles[order[slot].second];
+            ids[slot] = mIds[order[slot].second];
+            mSlots[ids[slot]] = (int)slot;
+        }
+        mRectangles.swap(rectangles);
+        mIds.swap(ids);
+
+        std::vector<std::pair<int, CompactBox>> entries;
+        for (auto& cell : mCells)
+        {
+            GridCell& grid = cell.second;
+            entries.clear();
+            for (size_t i = 0; i < grid.ids.size(); i++)
+                entries.push_back({ grid.ids[i], grid.boxes[i] });
+            std::sort(entries.begin(), entries.end(), [this](const std::pair<int, CompactBox>& a, const std::pair<int, CompactBox>& b)
+            {
+                return mSlots[a.first] < mSlots[b.first];
+            });
+            for (size_t i = 0; i < entries.size(); i++)
+            {
+                grid.ids[i] = entries[i].first;
+                grid.boxes[i] = entries[i].second;
+            }
+        }
+    }
+
+    // Ids of obstacles sharing a cell with area, each listed once
+    void QueryRect(Rectangle area, std::vector<int>& ids) const
+    {
+        ids.clear();
+        int x0, y0, x1, y1;
+        CellRange(area, x0, y0, x1, y1);
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                auto cell = mCells.find(CellKey(x, y));
+                if (cell != mCells.end()) ids.insert(ids.end(), cell->second.ids.begin(), cell->second.ids.end());
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    // Ids of obstacles overlapping area, each listed once. Fills the caller's buffer without sorting.
+    void QueryOverlaps(Rectangle area, std::vector<int>& ids) const
+    {
+        ids.clear();
+        VisitOverlapCandidates(area, [&](int id, const Rectangle& obstacle)
+        {
+            if (CheckCollisionRecs(obstacle, area)) ids.push_back(id);
+        });
+    }
+
+    // Ids of obstacles overlapping circle, each listed once
+    void QueryOverlaps(Circle circle, std::vector<int>& ids) const
+    {
+        ids.clear();
+        const Rectangle area{ circle.position.x - circle.radius, circle.position.y - circle.radius,
+            circle.radius * 2.0f, circle.radius * 2.0f };
+        VisitOverlapCandidates(area, [&](int id, const Rectangle& obstacle)
+        {
+            if (CheckCollisionCircleRec(circle, obstacle)) ids.push_back(id);
+        });
+    }
+
+    // Whether point lies inside or on the edge of any obstacle. Only reads the point's cell, never allocates.
+    bool ContainsPoint(Vector2 point) const
+    {
+        auto cell = mCells.find(CellKey(CellCoord(point.x), CellCoord(point.y)));
+        if (cell == mCells.end()) return false;
+
+        for (int id : cell->second.ids)
+        {
+            if (CheckCollisionPointRec(point, mRectangles[mSlots[id]])) return true;
+        }
+        return false;
+    }
+
+    // Up to k obstacles closest to point (distance 0 when inside), nearest first. Searches rings of cells
+    // outwards keeping the best k in a max-heap inside the caller's buffer, and stops once no closer
+    // obstacle can remain.
+    void QueryNearest(Vector2 point, int k, std::vector<ObstacleDistance>& nearest, float maxDistance = FLT_MAX) const
+    {
+        nearest.clear();
+        if (k <= 0 || mRectangles.empty()) return;
+
+        const float maxDistanceSqr = maxDistance < FLT_MAX ? maxDistance * maxDistance : FLT_MAX;
+        auto closer = [](const ObstacleDistance& a, const ObstacleDistance& b) { return a.distanceSqr < b.distanceSqr; };
+        auto consider = [&](const std::vector<int>& ids)
+        {
+            for (int id : ids)
+            {
+                const Rectangle& obstacle = mRectangles[mSlots[id]];
+                const float distanceSqr = DistanceSqr(point, NearestPointRec(point, obstacle));
+                if (distanceSqr > maxDistanceSqr) continue;
+                if ((int)nearest.size() == k && distanceSqr >= nearest.front().distanceSqr) continue;
+
+                // Obstacles spanning several cells come up more than once
+                bool listed = false;
+                for (const ObstacleDistance& entry : nearest)
+                    listed = listed || entry.id == id;
+                if (listed) continue;
+
+                nearest.push_back({ id, distanceSqr });
+                std::push_heap(nearest.begin(), nearest.end(), closer);
+                if ((int)nearest.size() > k)
+                {
+                    std::pop_heap(nearest.begin(), nearest.end(), closer);
+                    nearest.pop_back();
+                }
+            }
+        };
+
+        const int cx = CellCoord(point.x);
+        const int cy = CellCoord(point.y);
+        const int first = std::max(std::max(std::max(mMinX - cx, cx - mMaxX), std::max(mMinY - cy, cy - mMaxY)), 0);
+        const int last = std::max(std::max(abs(cx - mMinX), abs(cx - mMaxX)), std::max(abs(cy - mMinY), abs(cy - mMaxY)));
+        for (int ring = first; ring <= last; ring++)
+        {
+            // Every cell in this ring is at least this far from point
+            const float ringDistance = std::max(ring - 1, 0) * mCellSize;
+            if (ringDistance * ringDistance > maxDistanceSqr) break;
+            if ((int)nearest.size() == k && nearest.front().distanceSqr <= ringDistance * ringDistance) break;
+
+            for (int x = std::max(cx - ring, mMinX); x <= std::min(cx + ring, mMaxX); x++)
+            {
+                VisitCell(x, cy - ring, consider);
+                if (ring > 0) VisitCell(x, cy + ring, consider);
+            }
+            for (int y = std::max(cy - ring + 1, mMinY); y <= std::min(cy + ring - 1, mMaxY); y++)
+            {
+                VisitCell(cx - ring, y, consider);
+                if (ring > 0) VisitCell(cx + ring, y, consider);
+            }
+        }
+        std::sort_heap(nearest.begin(), nearest.end(), closer);
+    }
+
+    // Walks the occupied cells a segment crosses in order from start (Amanatides-Woo DDA). visit receives the
+    // cell's obstacle ids and the segment parameter where it leaves the cell, and returns false to stop.
+    template<typename Visitor>
+    void TraverseSegment(Vector2 start, Vector2 end, Visitor visit) const
+    {
+        int x = CellCoord(start.x);
+        int y = CellCoord(start.y);
+        const int endX = CellCoord(end.x);
+        const int endY = CellCoord(end.y);
+        const Vector2 delta = end - start;
+
+        const int stepX = delta.x > 0.0f ? 1 : -1;
+        const int stepY = delta.y > 0.0f ? 1 : -1;
+        const float deltaX = delta.x != 0.0f ? mCellSize / fabsf(delta.x) : FLT_MAX;
+        const float deltaY = delta.y != 0.0f ? mCellSize / fabsf(delta.y) : FLT_MAX;
+        float nextX = delta.x != 0.0f ? ((x + (stepX > 0 ? 1 : 0)) * mCellSize - start.x) / delta.x : FLT_MAX;
+        float nextY = delta.y != 0.0f ? ((y + (stepY > 0 ? 1 : 0)) * mCellSize - start.y) / delta.y : FLT_MAX;
+
+        for (int steps = abs(endX - x) + abs(endY - y); steps >= 0; steps--)
+        {
+            const float exit = std::min(std::min(nextX, nextY), 1.0f);
+            auto cell = mCells.find(CellKey(x, y));
+            if (cell != mCells.end() && !visit(cell->second.ids, exit)) return;
+
+            if (nextX < nextY)
+            {
+                x += stepX;
+                nextX += deltaX;
+            }
+            else
+            {
+                y += stepY;
+                nextY += deltaY;
+            }
+        }
+    }
+
+private:
+    template<typename Visitor>
+    void VisitCell(int x, int y, Visitor& visit) const
+    {
+        auto cell = mCells.find(CellKey(x, y));
+        if (cell != mCells.end()) visit(cell->second.ids);
+    }
+
+    // Each obstacle whose compact box overlaps area once, reported only from the cell holding the top left
+    // corner of its overlap with area. Rectangles are only read for boxes that pass.
+    template<typename Visitor>
+    void VisitOverlapCandidates(Rectangle area, Visitor visit) const
+    {
+        int x0, y0, x1, y1;
+        CellRange(area, x0, y0, x1, y1);
+        for (int y = y0; y <= y1; y++)
+        {
+            for (int x = x0; x <= x1; x++)
+            {
+                auto cell = mCells.find(CellKey(x, y));
+                if (cell == mCells.end()) continue;
+
+                const GridCell& entries = cell->second;
+                const CompactBox query = Compact(area, x, y);
+                for (size_t i = 0; i < entries.boxes.size(); i++)
+                {
+                    const CompactBox& box = entries.boxes[i];
+                    if (box.x0 > query.x1 || box.x1 < query.x0 || box.y0 > query.y1 || box.y1 < query.y0) continue;
+
+                    const int id = entries.ids[i];
+                    const Rectangle& obstacle = mRectangles[mSlots[id]];
+                    if (CellCoord(std::max(obstacle.x, area.x)) == x && CellCoord(std::max(obstacle.y, area.y)) == y)
+                        visit(id, obstacle);
+                }
+            }
+        }
+    }
+
+    // Part of rectangle inside cell (x, y) in cell-relative steps, min rounded down and max rounded up
+    CompactBox Compact(Rectangle rectangle, int x, int y) const
+    {
+        const float originX = x * mCellSize;
+        const float originY = y * mCellSize;
+        auto lower = [this](float value) { return (uint16_t)Clamp(floorf(value * mCompactScale), 0.0f, OBSTACLE_GRID_COMPACT_STEPS); };
+        auto upper = [this](float value) { return (uint16_t)Clamp(ceilf(value * mCompactScale), 0.0f, OBSTACLE_GRID_COMPACT_STEPS); };
+        return { lower(rectangle.x - originX), lower(rectangle.y - originY),
+            upper(rectangle.x + rectangle.width - originX), upper(rectangle.y + rectangle.height - originY) };
+    }
+
+    int CellCoord(float value) const
+    {
+        return (int)floorf(value * mInvCellSize);
+    }
+
+    void CellRange(Rectangle rectangle, int& x0, int& y0, int& x1, int& y1) const
+    {
+        x0 = CellCoord(rectangle.x);
+        y0 = CellCoord(rectangle.y);
+        x1 = CellCoord(rectangle.x + rectangle.width);
+        y1 = CellCoord(rectangle.y + rectangle.height);
+    }
+
+    static uint64_t CellKey(int x, int y)
+    {
+        return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+    }
+
+    float mCellSize;
+    float mInvCellSize;
+    float mCompactScale;
+    unsigned int mVersion = 0;
+    int mMinX = INT_MAX;    // occupied cell bounds
+    int mMinY = INT_MAX;
+    int mMaxX = INT_MIN;
+    int mMaxY = INT_MIN;
+    struct GridCell
+    {
+        std::vector<int> ids;
+        std::vector<CompactBox> boxes;  // parallel to ids
+    };
+    std::unordered_map<uint64_t, GridCell> mCells;
+
+    std::vector<Rectangle> mRectangles;     // dense
+    std::vector<int> mIds;                  // slot -> id
+    std::vector<int> mSlots;                // id -> slot, -1 when free
+    std::vector<int> mFreeIds;
+};
+
+// Nearest hit along the segment, cells are visited front to back so the walk stops at the first cell
+// that contains a hit
+bool NearestIntersection(Vector2 lineStart, Vector2 lineEnd, const ObstacleGrid& obstacles, Vector2& poi)
+{
+    const float length = Length(lineEnd - lineStart);
+    float nearest = FLT_MAX;
+    obstacles.TraverseSegment(lineStart, lineEnd, [&](const std::vector<int>& ids, float exit)
+    {
+        for (int id : ids)
+        {
+            Vector2 hit;
+            if (!CheckCollisionLineRec(lineStart, lineEnd, obstacles.Get(id), hit)) continue;
+
+            const float distance = DistanceSqr(lineStart, hit);
+            if (distance < nearest)
+            {
+                nearest = distance;
+                poi = hit;
+            }
+        }
+        return nearest > exit * length * exit * length;
+    });
+    return nearest < FLT_MAX;
+}
+
+// Whether obstacle crosses the segment closer than sqrt(distanceSqr) to its start
+bool IsSegmentBlockedBy(Vector2 lineStart, Vector2 lineEnd, float distanceSqr, Rectangle obstacle)
+{
+    Vector2 hit;
+    return CheckCollisionLineRec(lineStart, lineEnd, obstacle, hit) && DistanceSqr(lineStart, hit) < distanceSqr;
+}
+
+// Id of an obstacle crossing the segment closer than sqrt(distanceSqr) to its start, -1 if there is none
+int FindSegmentBlocker(Vector2 lineStart, Vector2 lineEnd, float distanceSqr, const ObstacleGrid& obstacles)
+{
+    const float length = Length(lineEnd - lineStart);
+    int blocker = -1;
+    obstacles.TraverseSegment(lineStart, lineEnd, [&](const std::vector<int>& ids, float exit)
+    {
+        for (int id : ids)
+        {
+            if (IsSegmentBlockedBy(lineStart, lineEnd, distanceSqr, obstacles.Get(id)))
+            {
+                blocker = id;
+                return false;
+            }
+        }
+        return exit * length * exit * length < distanceSqr;
+    });
+    return blocker;
+}
+
+// Whether any obstacle crosses the segment closer than sqrt(distanceSqr) to its start
+bool IsSegmentBlocked(Vector2 lineStart, Vector2 lineEnd, float distanceSqr, const ObstacleGrid& obstacles)
+{
+    return FindSegmentBlocker(lineStart, lineEnd, distanceSqr, obstacles) >= 0;
+}
+
+// Determines if circle is visible from line start
+bool IsCircleVisible(Vector2 lineStart, Vector2 lineEnd, Circle circle, const ObstacleGrid& obstacles)
+{
+    if (!CheckCollisionLineCircle(lineStart, lineEnd, circle)) return false;
+    return !IsSegmentBlocked(lineStart, lineEnd, DistanceSqr(lineStart, circle.position), obstacles);
+}
+
+// Determines if rectangle is visible from line start
+bool IsRectangleVisible(Vector2 lineStart, Vector2 lineEnd, Rectangle rectangle, const ObstacleGrid& obstacles)
+{
+    if (!CheckCollisionLineRec(lineStart, lineEnd, rectangle)) return false;
+    return !IsSegmentBlocked(lineStart, lineEnd, DistanceSqr(lineStart,
+        { rectangle.x + rectangle.width * 0.5f, rectangle.y + rectangle.height * 0.5f }), obstacles);
+}
+
+// Whether an oriented box overlaps any obstacle, ids of the overlapping ones in hits when given
+bool CheckCollisionOBBObstacles(const OrientedBox& box, const ObstacleGrid& obstacles, std::vector<int>& candidates,
+    std::vector<int>* hits = nullptr)
+{
+    if (hits != nullptr) hits->clear();
+    obstacles.QueryOverlaps(GetOrientedBoxBounds(box), candidates);
+    for (int id : candidates)
+    {
+        if (!CheckCollisionOBBRec(box, obstacles.Get(id))) continue;
+        if (hits == nullptr) return true;
+        hits->push_back(id);
+    }
+    return hits != nullptr && !hits->empty();
+}
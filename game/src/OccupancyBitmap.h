@@ -0,0 +1,207 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "ObstacleGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// World units per bitmap cell, smaller cells answer more queries without falling back to exact tests
+#define OCCUPANCY_CELL_SIZE 8.0f
+
+// Slack (in cells) so rounding never drops a touched cell from a span or adds an untouched one
+#define OCCUPANCY_EPSILON 1e-3f
+
+enum OcclusionResult
+{
+    OCCLUSION_CLEAR,        // no obstacle touches the segment
+    OCCLUSION_BLOCKED,      // the segment crosses a cell that is entirely obstacle
+    OCCLUSION_UNKNOWN       // only an exact test can tell
+};
+
+// Obstacles rasterised into packed bits, one layer for cells an obstacle touches and one for cells an
+// obstacle covers completely. Each layer is also kept transposed so segments are always walked along
+// their major axis, testing up to 64 cells per word.
+class OccupancyBitmap
+{
+public:
+    void Build(Rectangle bounds, const std::vector<Rectangle>& obstacles, float cellSize = OCCUPANCY_CELL_SIZE)
+    {
+        mBounds = bounds;
+        mCellSize = cellSize;
+        mInvCellSize = 1.0f / cellSize;
+        mWidth = std::max(1, (int)ceilf(bounds.width * mInvCellSize));
+        mHeight = std::max(1, (int)ceilf(bounds.height * mInvCellSize));
+        mRowWords = (mWidth + 63) / 64;
+        mColumnWords = (mHeight + 63) / 64;
+
+        mTouched.assign((size_t)mRowWords * mHeight, 0);
+        mSolid.assign((size_t)mRowWords * mHeight, 0);
+        mTouchedColumns.assign((size_t)mColumnWords * mWidth, 0);
+        mSolidColumns.assign((size_t)mColumnWords * mWidth, 0);
+
+        for (const Rectangle& obstacle : obstacles)
+        {
+            const float x0 = (obstacle.x - bounds.x) * mInvCellSize;
+            const float y0 = (obstacle.y - bounds.y) * mInvCellSize;
+            const float x1 = x0 + obstacle.width * mInvCellSize;
+            const float y1 = y0 + obstacle.height * mInvCellSize;
+            Rasterise((int)floorf(x0), (int)floorf(y0), (int)floorf(x1), (int)floorf(y1), mTouched, mTouchedColumns);
+            Rasterise((int)ceilf(x0), (int)ceilf(y0), (int)floorf(x1) - 1, (int)floorf(y1) - 1, mSolid, mSolidColumns);
+        }
+    }
+
+    void Build(Rectangle bounds, const ObstacleGrid& obstacles, float cellSize = OCCUPANCY_CELL_SIZE)
+    {
+        Build(bounds, obstacles.Rectangles(), cellSize);
+        mVersion = obstacles.Version();
+    }
+
+    // Grid version the bitmap was built from
+    unsigned int Version() const
+    {
+        return mVersion;
+    }
+
+    Rectangle Bounds() const
+    {
+        return mBounds;
+    }
+
+    float CellSize() const
+    {
+        return mCellSize;
+    }
+
+    // Conservative classification of the segment, obstacles outside the bounds are unknown so
+    // a segment leaving the bounds is never reported clear
+    OcclusionResult TestSegment(Vector2 start, Vector2 end) const
+    {
+        if (mWidth == 0) return OCCLUSION_UNKNOWN;
+
+        // Cell space, then walk along whichever axis the segment travels further in
+        Vector2 a{ (start.x - mBounds.x) * mInvCellSize, (start.y - mBounds.y) * mInvCellSize };
+        Vector2 b{ (end.x - mBounds.x) * mInvCellSize, (end.y - mBounds.y) * mInvCellSize };
+        const bool steep = fabsf(b.y - a.y) > fabsf(b.x - a.x);
+        if (steep)
+        {
+            std::swap(a.x, a.y);
+            std::swap(b.x, b.y);
+        }
+        if (a.y > b.y) std::swap(a, b);
+
+        const int lines = steep ? mWidth : mHeight;
+        const int length = steep ? mHeight : mWidth;
+        const int words = steep ? mColumnWords : mRowWords;
+        const std::vector<uint64_t>& touched = steep ? mTouchedColumns : mTouched;
+        const std::vector<uint64_t>& solid = steep ? mSolidColumns : mSolid;
+
+        const bool inside = std::min(a.x, b.x) >= 0.0f && std::max(a.x, b.x) < (float)length &&
+            a.y >= 0.0f && b.y < (float)lines;
+        const float slope = b.y != a.y ? (b.x - a.x) / (b.y - a.y) : 0.0f;
+
+        // Lines just past either end are included in case rounding put the segment there
+        bool anyTouched = false;
+        const int first = std::max(0, (int)floorf(a.y - OCCUPANCY_EPSILON));
+        const int last = std::min(lines - 1, (int)floorf(b.y + OCCUPANCY_EPSILON));
+        for (int line = first; line <= last; line++)
+        {
+            // Part of the segment inside this line's band
+            const float bandStart = Clamp((float)line, a.y, b.y);
+            const float bandEnd = Clamp((float)(line + 1), a.y, b.y);
+            const float x0 = a.y != b.y ? a.x + (bandStart - a.y) * slope : a.x;
+            const float x1 = a.y != b.y ? a.x + (bandEnd - a.y) * slope : b.x;
+            const float lo = std::min(x0, x1);
+            const float hi = std::max(x0, x1);
+
+            const uint64_t* row = &touched[(size_t)line * words];
+            if (!AnySet(row, length, (int)floorf(lo - OCCUPANCY_EPSILON), (int)floorf(hi + OCCUPANCY_EPSILON))) continue;
+            anyTouched = true;
+
+            // Blocked only if the segment passes through a solid cell's interior, the exact tests don't count
+            // grazing an edge
+            const float innerStart = std::max(bandStart, line + OCCUPANCY_EPSILON);
+            const float innerEnd = std::min(bandEnd, line + 1.0f - OCCUPANCY_EPSILON);
+            if (innerStart > innerEnd) continue;
+
+            const float inner0 = a.y != b.y ? a.x + (innerStart - a.y) * slope : a.x;
+            const float inner1 = a.y != b.y ? a.x + (innerEnd - a.y) * slope : b.x;
+            row = &solid[(size_t)line * words];
+            if (AnySet(row, length, (int)floorf(std::min(inner0, inner1) + OCCUPANCY_EPSILON),
+                (int)floorf(std::max(inner0, inner1) - OCCUPANCY_EPSILON)))
+                return OCCLUSION_BLOCKED;
+        }
+        return anyTouched || !inside ? OCCLUSION_UNKNOWN : OCCLUSION_CLEAR;
+    }
+
+private:
+    // Sets the cells [x0, x1] x [y0, y1] in both layouts
+    void Rasterise(int x0, int y0, int x1, int y1, std::vector<uint64_t>& rows, std::vector<uint64_t>& columns)
+    {
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, mWidth - 1);
+        y1 = std::min(y1, mHeight - 1);
+        if (x0 > x1 || y0 > y1) return;
+
+        for (int y = y0; y <= y1; y++)
+            SetSpan(&rows[(size_t)y * mRowWords], x0, x1);
+        for (int x = x0; x <= x1; x++)
+            SetSpan(&columns[(size_t)x * mColumnWords], y0, y1);
+    }
+
+    static uint64_t SpanMask(int word, int from, int to)
+    {
+        const int lo = std::max(from - word * 64, 0);
+        const int hi = std::min(to - word * 64, 63);
+        const uint64_t upper = hi == 63 ? ~0ull : (1ull << (hi + 1)) - 1;
+        return upper & ~((1ull << lo) - 1);
+    }
+
+    static void SetSpan(uint64_t* words, int from, int to)
+    {
+        for (int word = from / 64; word <= to / 64; word++)
+            words[word] |= SpanMask(word, from, to);
+    }
+
+    // Whether any cell in [from, to] of a line is set, clamped to the line
+    static bool AnySet(const uint64_t* words, int length, int from, int to)
+    {
+        from = std::max(from, 0);
+        to = std::min(to, length - 1);
+        if (from > to) return false;
+
+        for (int word = from / 64; word <= to / 64; word++)
+        {
+            if (words[word] & SpanMask(word, from, to)) return true;
+        }
+        return false;
+    }
+
+    Rectangle mBounds{};
+    float mCellSize = OCCUPANCY_CELL_SIZE;
+    float mInvCellSize = 1.0f / OCCUPANCY_CELL_SIZE;
+    int mWidth = 0;
+    int mHeight = 0;
+    int mRowWords = 0;
+    int mColumnWords = 0;
+    unsigned int mVersion = 0;
+
+    std::vector<uint64_t> mTouched;         // row major
+    std::vector<uint64_t> mSolid;
+    std::vector<uint64_t> mTouchedColumns;  // column major
+    std::vector<uint64_t> mSolidColumns;
+};
+
+// Whether the segment touches any obstacle, including lying entirely inside one. The bitmap answers first
+// and exact segment tests only run when it can't decide.
+bool IsSegmentBlocked(Vector2 lineStart, Vector2 lineEnd, const OccupancyBitmap& bitmap, const ObstacleGrid& obstacles)
+{
+    const OcclusionResult coarse = bitmap.TestSegment(lineStart, lineEnd);
+    if (coarse != OCCLUSION_UNKNOWN) return coarse == OCCLUSION_BLOCKED;
+    if (FindSegmentBlocker(lineStart, lineEnd, DistanceSqr(lineStart, lineEnd) * (1.0f + 1e-5f), obstacles) >= 0) return true;
+
+    // A segment that crosses no edge is either clear or starts inside an obstacle
+    return obstacles.ContainsPoint(lineStart);
+}
@@ -1,10 +1,14 @@
 #pragma once
 #include "Math.h"
+#include "Fixed.h"
 
 struct Rigidbody
 {
     Vector2 vel{ 0.0f, 0.0f };
     Vector2 acc{ 0.0f, 0.0f };
+    float invMass = 1.0f;       // 0 for bodies contacts can't push
+    float friction = 0.5f;
+    float restitution = 0.0f;   // 0 stops dead, 1 bounces back at full speed
 };
 
 // v2 = v1 + a(t)
@@ -15,26 +19,56 @@ Vector2 Integrate(const Vector2& pos, Rigidbody& rb, float dt)
     return pos + rb.vel * dt + rb.acc * dt * dt * 0.5f;
 }
 
+// Rigidbody on the simulation scalar, what the lockstep simulation steps
+struct ScalarRigidbody
+{
+    ScalarVector2 vel{};
+    ScalarVector2 acc{};
+};
+
+// Integrate on Scalar, the same bits on every machine in fixed point
+ScalarVector2 Integrate(const ScalarVector2& pos, ScalarRigidbody& rb, Scalar dt)
+{
+    rb.vel = rb.vel + rb.acc * dt;
+    return pos + rb.vel * dt + rb.acc * (dt * dt / Scalar(2));
+}
+
+// Integrate split in two so contacts can change the velocity in between (semi-implicit Euler)
+// v2 = v1 + a(t)
+void IntegrateVelocity(Rigidbody& rb, float dt)
+{
+    rb.vel = rb.vel + rb.acc * dt;
+}
+
+// p2 = p1 + v2(t)
+Vector2 IntegratePosition(const Vector2& pos, const Rigidbody& rb, float dt)
+{
+    return pos + rb.vel * dt;
+}
+
 // vf^2 = vi^2 + 2a(d)
 // 0^2 = vi^2 + 2a(d)
 // -vi^2 / 2d = a
-Vector2 Decelerate(
-    const Vector2& targetPosition,
-    const Vector2& seekerPosition,
-    const Vector2& seekerVelocity)
+// Vector2 or ScalarVector2
+template<typename V>
+V Decelerate(
+    const V& targetPosition,
+    const V& seekerPosition,
+    const V& seekerVelocity)
 {
-    float d = Length(targetPosition - seekerPosition);
-    float a = Dot(seekerVelocity, seekerVelocity) / (d * 2.0f);
+    auto d = Length(targetPosition - seekerPosition);
+    auto a = Dot(seekerVelocity, seekerVelocity) / (d + d);
 
     return Negate(Normalize(seekerVelocity)) * a;
 }
 
 // Accelerate towards target
-Vector2 Seek(
-    const Vector2& targetPosition,
-    const Vector2& seekerPosition,
-    const Vector2& seekerVelocity, float maxSpeed)
+template<typename V, typename T>
+V Seek(
+    const V& targetPosition,
+    const V& seekerPosition,
+    const V& seekerVelocity, T maxSpeed)
 {
-    Vector2 desiredVelocity = Normalize(targetPosition - seekerPosition) * maxSpeed;
+    V desiredVelocity = Normalize(targetPosition - seekerPosition) * maxSpeed;
     return desiredVelocity - seekerVelocity;
 }
\ No newline at end of file
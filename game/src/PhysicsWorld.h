@@ -0,0 +1,781 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "Physics.h"
+#include "Broadphase.h"
+#include "ObstacleGrid.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Solver passes per step, warm starting is what lets stacks settle with this few
+#define PHYSICS_ITERATIONS 4
+
+// Penetration left alone so resting contacts still touch next step
+#define PHYSICS_SLOP 0.5f
+
+// Fraction of the penetration past the slop pushed out per step. The push only moves positions and is dropped
+// afterwards, feeding it back into velocities makes tall stacks bounce.
+#define PHYSICS_BAUMGARTE 0.2f
+
+// Closing speeds below this don't bounce, otherwise resting bodies jitter
+#define PHYSICS_RESTITUTION_THRESHOLD 30.0f
+
+// Bodies closer than this get a contact before they touch, so a stack that separates by a hair for a step
+// doesn't lose its contacts and the impulses they carry
+#define PHYSICS_MARGIN 2.0f
+
+// An island goes to sleep once every body in it has moved slower than this for PHYSICS_SLEEP_TIME seconds
+#define PHYSICS_SLEEP_SPEED 5.0f
+#define PHYSICS_SLEEP_TIME 0.5f
+
+// Islands with more contacts than this are coloured and solved one colour at a time across threads. It's fixed
+// rather than scaled to the thread count so the solve order, and the answer, is the same on every machine.
+#define PHYSICS_SPLIT_CONTACTS 128
+
+// Colours available to a split island, contacts that don't fit in any are solved on one thread after the rest
+#define PHYSICS_MAX_COLOURS 64
+
+// Fewest contacts of one colour handed to a thread
+#define PHYSICS_COLOUR_BATCH 32
+
+// Axis-aligned box, position is the centre
+struct PhysicsBody
+{
+    Vector2 position{};
+    Vector2 halfExtents{};
+    Rigidbody rb;
+    Vector2 push{};         // velocity pushing this body out of penetration, this step only
+    float sleepTime = 0.0f; // how long it's been below PHYSICS_SLEEP_SPEED
+    int sleepIsland = -1;   // sleeping island it belongs to, -1 while awake
+    int proxy = -1;
+    bool alive = false;
+};
+
+// Contact between two bodies or a body and an obstacle. Boxes don't rotate so one point per manifold is enough.
+struct ContactManifold
+{
+    int a;
+    int b;                  // -1 against an obstacle
+    int obstacle;           // -1 between bodies
+    Vector2 normal;         // from a towards b
+    float penetration;      // negative while there's still a gap
+    float normalImpulse;    // accumulated, carried over to the next step while the contact lasts
+    float tangentImpulse;
+    float mass;             // effective mass along the normal and tangent
+    float friction;
+    float restitution;
+    float bias;             // separating speed the solver aims for
+    float pushImpulse;      // accumulated position correction, starts from 0 every step
+    float pushBias;
+};
+
+// Awake bodies joined by contacts, solved as a unit. Static and kinematic bodies (invMass 0) and obstacles never
+// join two islands together. Ranges index the world's island bodies and contacts.
+struct PhysicsIsland
+{
+    int firstBody;
+    int bodyCount;
+    int firstContact;
+    int contactCount;
+    bool pinned;            // touching a moving kinematic body, so it can't sleep
+};
+
+// Box bodies stepped with a sequential impulse solver. Contacts persist between steps and start from last
+// step's impulses (warm starting), so a stack that was holding still needs only a few passes to keep holding.
+// Islands that stop moving are put to sleep and skipped entirely until something touches them.
+class PhysicsWorld
+{
+public:
+    // Returns a stable id, valid until the body is removed
+    int AddBody(Rectangle bounds, const Rigidbody& rb = Rigidbody())
+    {
+        int id;
+        if (mFreeIds.empty())
+        {
+            id = (int)mBodies.size();
+            mBodies.push_back({});
+        }
+        else
+        {
+            id = mFreeIds.back();
+            mFreeIds.pop_back();
+        }
+
+        PhysicsBody& body = mBodies[id];
+        body.halfExtents = { bounds.width * 0.5f, bounds.height * 0.5f };
+        body.position = { bounds.x + body.halfExtents.x, bounds.y + body.halfExtents.y };
+        body.rb = rb;
+        body.push = { 0.0f, 0.0f };
+        body.sleepTime = 0.0f;
+        body.alive = true;
+        body.proxy = mBroadphase.Insert(FatBounds(body));
+        if (body.proxy >= (int)mProxyBodies.size()) mProxyBodies.resize(body.proxy + 1, -1);
+        mProxyBodies[body.proxy] = id;
+        return id;
+    }
+
+    // Wakes anything the body was touching. The id isn't reused until after the next Step, so a new body can't
+    // warm start from the removed one's contacts.
+    void RemoveBody(int id)
+    {
+        if (!Contains(id)) return;
+
+        PhysicsBody& body = mBodies[id];
+        WakeBody(id);
+        for (const BroadphasePair& pair : mBroadphase.Pairs())
+        {
+            if (pair.a == body.proxy) WakeBody(mProxyBodies[pair.b]);
+            else if (pair.b == body.proxy) WakeBody(mProxyBodies[pair.a]);
+        }
+        mBroadphase.Remove(body.proxy);
+        mProxyBodies[body.proxy] = -1;
+        body.proxy = -1;
+        body.alive = false;
+        mRemovedIds.push_back(id);
+    }
+
+    bool Contains(int id) const
+    {
+        return id >= 0 && id < (int)mBodies.size() && mBodies[id].alive;
+    }
+
+    // Changing a sleeping body through this doesn't wake it, call WakeBody afterwards
+    PhysicsBody& GetBody(int id)
+    {
+        return mBodies[id];
+    }
+
+    const PhysicsBody& GetBody(int id) const
+    {
+        return mBodies[id];
+    }
+
+    Rectangle GetBounds(int id) const
+    {
+        return Bounds(mBodies[id]);
+    }
+
+    // Indexed by id, removed bodies stay in place with alive false
+    const std::vector<PhysicsBody>& Bodies() const
+    {
+        return mBodies;
+    }
+
+    // Wakes the body and the rest of its island
+    void WakeBody(int id)
+    {
+        if (Contains(id) && mBodies[id].sleepIsland >= 0) WakeIsland(mBodies[id].sleepIsland);
+    }
+
+    bool IsAwake(int id) const
+    {
+        return mBodies[id].sleepIsland < 0;
+    }
+
+    // Changes the body's velocity by impulse * invMass, waking it
+    void AddImpulse(int id, Vector2 impulse)
+    {
+        if (!Contains(id)) return;
+
+        WakeBody(id);
+        Rigidbody& rb = mBodies[id].rb;
+        rb.vel = rb.vel + impulse * rb.invMass;
+    }
+
+    // Contacts found by the last Step, sleeping islands' contacts aren't included
+    const std::vector<ContactManifold>& Contacts() const
+    {
+        return mContacts;
+    }
+
+    // Islands solved by the last Step
+    const std::vector<PhysicsIsland>& Islands() const
+    {
+        return mIslands;
+    }
+
+    void SetIterations(int iterations)
+    {
+        mIterations = std::max(iterations, 1);
+    }
+
+    int Iterations() const
+    {
+        return mIterations;
+    }
+
+    void SetWarmStarting(bool warmStarting)
+    {
+        mWarmStarting = warmStarting;
+    }
+
+    bool WarmStarting() const
+    {
+        return mWarmStarting;
+    }
+
+    // Bodies with invMass 0 still move by their velocity but nothing pushes them. Islands are solved on the
+    // pool, the result doesn't depend on how many threads it has.
+    void Step(float dt, const ObstacleGrid& obstacles, ThreadPool& pool = DefaultThreadPool())
+    {
+        if (dt <= 0.0f) return;
+
+        // An edited obstacle may have been holding something up
+        if (obstacles.Version() != mObstacleVersion)
+        {
+            mObstacleVersion = obstacles.Version();
+            for (int island = 0; island < (int)mSleepingIslands.size(); island++)
+                WakeIsland(island);
+        }
+
+        for (PhysicsBody& body : mBodies)
+        {
+            if (body.alive && body.rb.invMass > 0.0f && body.sleepIsland < 0)
+                IntegrateVelocity(body.rb, dt);
+        }
+
+        FindContacts(obstacles);
+        BuildIslands();
+        SolveIslands(dt, pool);
+
+        for (PhysicsBody& body : mBodies)
+        {
+            if (!body.alive || body.sleepIsland >= 0) continue;
+
+            body.position = IntegratePosition(body.position, body.rb, dt) + body.push * dt;
+            body.push = { 0.0f, 0.0f };
+        }
+
+        for (const PhysicsIsland& island : mIslands)
+            UpdateSleep(island, dt);
+
+        // Nothing kept for warm starting refers to these any more
+        mFreeIds.insert(mFreeIds.end(), mRemovedIds.begin(), mRemovedIds.end());
+        mRemovedIds.clear();
+    }
+
+private:
+    // Bodies and contacts of an island as it fell asleep, nothing in it moves until it wakes
+    struct SleepingIsland
+    {
+        std::vector<int> bodies;
+        std::vector<ContactManifold> contacts;
+        bool alive;
+    };
+
+    static Rectangle Bounds(const PhysicsBody& body)
+    {
+        return { body.position.x - body.halfExtents.x, body.position.y - body.halfExtents.y,
+            body.halfExtents.x * 2.0f, body.halfExtents.y * 2.0f };
+    }
+
+    static Rectangle FatBounds(const PhysicsBody& body)
+    {
+        const Rectangle bounds = Bounds(body);
+        return { bounds.x - PHYSICS_MARGIN, bounds.y - PHYSICS_MARGIN,
+            bounds.width + PHYSICS_MARGIN * 2.0f, bounds.height + PHYSICS_MARGIN * 2.0f };
+    }
+
+    // Body pairs and obstacles are keyed apart by the top bit
+    static uint64_t ContactKey(int a, int b, int obstacle)
+    {
+        return obstacle >= 0 ? (1ull << 63) | ((uint64_t)(uint32_t)a << 32) | (uint32_t)obstacle :
+            ((uint64_t)(uint32_t)a << 32) | (uint32_t)b;
+    }
+
+    // Whether the body can disturb what it touches: awake dynamic bodies and kinematic bodies that are moving
+    static bool IsActive(const PhysicsBody& body)
+    {
+        return body.rb.invMass > 0.0f ? body.sleepIsland < 0 : body.rb.vel.x != 0.0f || body.rb.vel.y != 0.0f;
+    }
+
+    void FindContacts(const ObstacleGrid& obstacles)
+    {
+        // Sleeping bodies haven't moved
+        for (const PhysicsBody& body : mBodies)
+        {
+            if (body.alive && body.sleepIsland < 0)
+                mBroadphase.Move(body.proxy, FatBounds(body));
+        }
+        mBroadphase.Update();
+
+        mPrevious.swap(mContacts);
+        mContacts.clear();
+
+        // Anything active near a sleeping body wakes its island, which may be near another one in turn
+        bool woke = mSleepingCount > 0;
+        while (woke)
+        {
+            woke = false;
+            for (const BroadphasePair& pair : mBroadphase.Pairs())
+            {
+                const PhysicsBody& a = mBodies[mProxyBodies[pair.a]];
+                const PhysicsBody& b = mBodies[mProxyBodies[pair.b]];
+                if (b.sleepIsland >= 0 && IsActive(a)) WakeIsland(b.sleepIsland);
+                else if (a.sleepIsland >= 0 && IsActive(b)) WakeIsland(a.sleepIsland);
+                else continue;
+                woke = true;
+            }
+        }
+
+        // Islands that just woke pick up the impulses they fell asleep with
+        for (const ContactManifold& contact : mWokenContacts)
+        {
+            mPreviousIndex[ContactKey(contact.a, contact.b, contact.obstacle)] = (int)mPrevious.size();
+            mPrevious.push_back(contact);
+        }
+        mWokenContacts.clear();
+
+        for (const BroadphasePair& pair : mBroadphase.Pairs())
+        {
+            const int a = std::min(mProxyBodies[pair.a], mProxyBodies[pair.b]);
+            const int b = std::max(mProxyBodies[pair.a], mProxyBodies[pair.b]);
+            const PhysicsBody& bodyA = mBodies[a];
+            const PhysicsBody& bodyB = mBodies[b];
+            if ((bodyA.rb.invMass > 0.0f || bodyB.rb.invMass > 0.0f) && (IsActive(bodyA) || IsActive(bodyB)))
+                Collide(a, b, -1, Bounds(bodyB));
+        }
+
+        for (int id = 0; id < (int)mBodies.size(); id++)
+        {
+            const PhysicsBody& body = mBodies[id];
+            if (!body.alive || body.rb.invMass <= 0.0f || body.sleepIsland >= 0) continue;
+
+            obstacles.QueryRect(FatBounds(body), mObstacleIds);
+            for (int obstacle : mObstacleIds)
+                Collide(id, -1, obstacle, obstacles.Get(obstacle));
+        }
+
+        // Broadphase order changes from step to step, a fixed order keeps the solver's answer repeatable
+        std::sort(mContacts.begin(), mContacts.end(), [](const ContactManifold& lhs, const ContactManifold& rhs)
+        {
+            return ContactKey(lhs.a, lhs.b, lhs.obstacle) < ContactKey(rhs.a, rhs.b, rhs.obstacle);
+        });
+
+        mPreviousIndex.clear();
+        for (int i = 0; i < (int)mContacts.size(); i++)
+        {
+            const ContactManifold& contact = mContacts[i];
+            mPreviousIndex[ContactKey(contact.a, contact.b, contact.obstacle)] = i;
+        }
+    }
+
+    // Pushes out along the axis of least overlap, or the axis of the gap when they're apart. other is body b's
+    // bounds or the obstacle's.
+    void Collide(int a, int b, int obstacle, Rectangle other)
+    {
+        const Rectangle self = Bounds(mBodies[a]);
+        const float overlapX = std::min(self.x + self.width, other.x + other.width) - std::max(self.x, other.x);
+        const float overlapY = std::min(self.y + self.height, other.y + other.height) - std::max(self.y, other.y);
+        if (overlapX <= -PHYSICS_MARGIN || overlapY <= -PHYSICS_MARGIN || (overlapX <= 0.0f && overlapY <= 0.0f)) return;
+
+        const Vector2 delta{ (other.x + other.width * 0.5f) - (self.x + self.width * 0.5f),
+            (other.y + other.height * 0.5f) - (self.y + self.height * 0.5f) };
+        ContactManifold contact{};
+        contact.a = a;
+        contact.b = b;
+        contact.obstacle = obstacle;
+        if (overlapY > 0.0f && overlapX < overlapY)
+        {
+            contact.normal = { delta.x < 0.0f ? -1.0f : 1.0f, 0.0f };
+            contact.penetration = overlapX;
+        }
+        else
+        {
+            contact.normal = { 0.0f, delta.y < 0.0f ? -1.0f : 1.0f };
+            contact.penetration = overlapY;
+        }
+
+        // Carry the impulses over if the same contact existed last step and still pushes the same way
+        auto previous = mPreviousIndex.find(ContactKey(a, b, obstacle));
+        if (previous != mPreviousIndex.end())
+        {
+            const ContactManifold& old = mPrevious[previous->second];
+            if (Dot(old.normal, contact.normal) > 0.99f)
+            {
+                contact.normalImpulse = old.normalImpulse;
+                contact.tangentImpulse = old.tangentImpulse;
+            }
+        }
+        mContacts.push_back(contact);
+    }
+
+    int FindRoot(int id)
+    {
+        while (mParents[id] != id)
+        {
+            mParents[id] = mParents[mParents[id]];
+            id = mParents[id];
+        }
+        return id;
+    }
+
+    // Union-find over the contacts between awake dynamic bodies. The lowest id in a set is always its root, so
+    // islands come out ordered by their lowest body and every island's bodies and contacts keep their sorted order.
+    void BuildIslands()
+    {
+        const int bodyCount = (int)mBodies.size();
+        mParents.resize(bodyCount);
+        for (int id = 0; id < bodyCount; id++)
+            mParents[id] = id;
+
+        for (const ContactManifold& contact : mContacts)
+        {
+            if (contact.b < 0 || mBodies[contact.a].rb.invMass <= 0.0f || mBodies[contact.b].rb.invMass <= 0.0f) continue;
+
+            const int a = FindRoot(contact.a);
+            const int b = FindRoot(contact.b);
+            if (a < b) mParents[b] = a;
+            else if (b < a) mParents[a] = b;
+        }
+
+        // Roots come before the rest of their set, so each body's island is known by the time it's reached
+        mIslands.clear();
+        mBodyIslands.assign(bodyCount, -1);
+        for (int id = 0; id < bodyCount; id++)
+        {
+            const PhysicsBody& body = mBodies[id];
+            if (!body.alive || body.rb.invMass <= 0.0f || body.sleepIsland >= 0) continue;
+
+            const int root = FindRoot(id);
+            if (root == id)
+            {
+                mBodyIslands[id] = (int)mIslands.size();
+                mIslands.push_back({ 0, 0, 0, 0, false });
+            }
+            else
+            {
+                mBodyIslands[id] = mBodyIslands[root];
+            }
+            mIslands[mBodyIslands[id]].bodyCount++;
+        }
+
+        // Every contact has at least one dynamic body, which places it
+        for (const ContactManifold& contact : mContacts)
+        {
+            const bool dynamicA = mBodies[contact.a].rb.invMass > 0.0f;
+            PhysicsIsland& island = mIslands[mBodyIslands[dynamicA ? contact.a : contact.b]];
+            island.contactCount++;
+
+            const PhysicsBody* other = contact.b < 0 ? nullptr : &mBodies[dynamicA ? contact.b : contact.a];
+            if (other != nullptr && other->rb.invMass <= 0.0f && IsActive(*other)) island.pinned = true;
+        }
+
+        int firstBody = 0, firstContact = 0;
+        for (PhysicsIsland& island : mIslands)
+        {
+            island.firstBody = firstBody;
+            island.firstContact = firstContact;
+            firstBody += island.bodyCount;
+            firstContact += island.contactCount;
+            island.bodyCount = 0;
+            island.contactCount = 0;
+        }
+
+        mIslandBodies.resize(firstBody);
+        mIslandContacts.resize(firstContact);
+        for (int id = 0; id < bodyCount; id++)
+        {
+            if (mBodyIslands[id] < 0) continue;
+            PhysicsIsland& island = mIslands[mBodyIslands[id]];
+            mIslandBodies[island.firstBody + island.bodyCount++] = id;
+        }
+        for (int i = 0; i < (int)mContacts.size(); i++)
+        {
+            const ContactManifold& contact = mContacts[i];
+            PhysicsIsland& island = mIslands[mBodyIslands[mBodies[contact.a].rb.invMass > 0.0f ? contact.a : contact.b]];
+            mIslandContacts[island.firstContact + island.contactCount++] = i;
+        }
+    }
+
+    void SolveIsland(const PhysicsIsland& island, float dt)
+    {
+        const int* contacts = mIslandContacts.data() + island.firstContact;
+        for (int i = 0; i < island.contactCount; i++)
+            PrepareContact(mContacts[contacts[i]], dt);
+
+        for (int iteration = 0; iteration < mIterations; iteration++)
+        {
+            for (int i = 0; i < island.contactCount; i++)
+                SolveContact(mContacts[contacts[i]]);
+            for (int i = 0; i < island.contactCount; i++)
+                SolvePush(mContacts[contacts[i]]);
+        }
+    }
+
+    // Islands share no bodies that contacts can push, so they're solved in any order on any thread with the same
+    // result. Largest first so a long one doesn't start last, the split ones one after another with the whole
+    // pool on each.
+    void SolveIslands(float dt, ThreadPool& pool)
+    {
+        mIslandOrder.resize(mIslands.size());
+        for (int i = 0; i < (int)mIslands.size(); i++)
+            mIslandOrder[i] = i;
+        std::stable_sort(mIslandOrder.begin(), mIslandOrder.end(), [this](int lhs, int rhs)
+        {
+            return mIslands[lhs].contactCount > mIslands[rhs].contactCount;
+        });
+
+        size_t first = 0;
+        for (; first < mIslandOrder.size() && mIslands[mIslandOrder[first]].contactCount > PHYSICS_SPLIT_CONTACTS; first++)
+            SolveSplitIsland(mIslands[mIslandOrder[first]], dt, pool);
+
+        // Each thread takes the next island when it finishes one
+        std::atomic<size_t> next{ first };
+        ParallelFor(pool, std::min(mIslandOrder.size() - first, pool.Size() + 1), 1, [&](size_t, size_t)
+        {
+            for (size_t i = next++; i < mIslandOrder.size(); i = next++)
+                SolveIsland(mIslands[mIslandOrder[i]], dt);
+        });
+    }
+
+    // Greedy colouring in contact order, no two contacts of a colour share a body contacts can push. Reorders the
+    // island's contacts by colour and leaves where each colour starts in mColourStarts.
+    void ColourContacts(const PhysicsIsland& island)
+    {
+        int* contacts = mIslandContacts.data() + island.firstContact;
+        const int* bodies = mIslandBodies.data() + island.firstBody;
+        mColourMasks.resize(mBodies.size());
+        for (int i = 0; i < island.bodyCount; i++)
+            mColourMasks[bodies[i]] = 0;
+
+        int counts[PHYSICS_MAX_COLOURS + 1] = {};
+        mContactColours.resize(island.contactCount);
+        for (int i = 0; i < island.contactCount; i++)
+        {
+            const ContactManifold& contact = mContacts[contacts[i]];
+            const bool dynamicA = mBodies[contact.a].rb.invMass > 0.0f;
+            const bool dynamicB = contact.b >= 0 && mBodies[contact.b].rb.invMass > 0.0f;
+            const uint64_t used = (dynamicA ? mColourMasks[contact.a] : 0) | (dynamicB ? mColourMasks[contact.b] : 0);
+
+            int colour = 0;
+            while (colour < PHYSICS_MAX_COLOURS && (used & (1ull << colour))) colour++;
+            if (colour < PHYSICS_MAX_COLOURS)
+            {
+                if (dynamicA) mColourMasks[contact.a] |= 1ull << colour;
+                if (dynamicB) mColourMasks[contact.b] |= 1ull << colour;
+            }
+            mContactColours[i] = colour;
+            counts[colour]++;
+        }
+
+        mColourStarts.assign(PHYSICS_MAX_COLOURS + 2, 0);
+        for (int colour = 0; colour <= PHYSICS_MAX_COLOURS; colour++)
+            mColourStarts[colour + 1] = mColourStarts[colour] + counts[colour];
+
+        mColourScratch.resize(island.contactCount);
+        for (int colour = 0; colour <= PHYSICS_MAX_COLOURS; colour++)
+            counts[colour] = mColourStarts[colour];
+        for (int i = 0; i < island.contactCount; i++)
+            mColourScratch[counts[mContactColours[i]]++] = contacts[i];
+        std::copy(mColourScratch.begin(), mColourScratch.end(), contacts);
+    }
+
+    // Runs solve on every contact of the split island, a colour at a time
+    template<typename Solve>
+    void ForEachColour(const PhysicsIsland& island, ThreadPool& pool, Solve solve)
+    {
+        const int* contacts = mIslandContacts.data() + island.firstContact;
+        for (int colour = 0; colour < PHYSICS_MAX_COLOURS; colour++)
+        {
+            const int begin = mColourStarts[colour];
+            ParallelFor(pool, mColourStarts[colour + 1] - begin, PHYSICS_COLOUR_BATCH, [&](size_t from, size_t to)
+            {
+                for (size_t i = from; i < to; i++)
+                    solve(mContacts[contacts[begin + i]]);
+            });
+        }
+
+        // The ones that didn't fit share bodies, so in order on this thread
+        for (int i = mColourStarts[PHYSICS_MAX_COLOURS]; i < mColourStarts[PHYSICS_MAX_COLOURS + 1]; i++)
+            solve(mContacts[contacts[i]]);
+    }
+
+    // Same passes as SolveIsland in colour order
+    void SolveSplitIsland(const PhysicsIsland& island, float dt, ThreadPool& pool)
+    {
+        ColourContacts(island);
+        ForEachColour(island, pool, [this, dt](ContactManifold& contact) { PrepareContact(contact, dt); });
+        for (int iteration = 0; iteration < mIterations; iteration++)
+        {
+            ForEachColour(island, pool, [this](ContactManifold& contact) { SolveContact(contact); });
+            ForEachColour(island, pool, [this](ContactManifold& contact) { SolvePush(contact); });
+        }
+    }
+
+    // Puts the island to sleep once all of it has been slow for long enough
+    void UpdateSleep(const PhysicsIsland& island, float dt)
+    {
+        const int* bodies = mIslandBodies.data() + island.firstBody;
+        float sleepTime = FLT_MAX;
+        for (int i = 0; i < island.bodyCount; i++)
+        {
+            PhysicsBody& body = mBodies[bodies[i]];
+            body.sleepTime = LengthSqr(body.rb.vel) > PHYSICS_SLEEP_SPEED * PHYSICS_SLEEP_SPEED ? 0.0f : body.sleepTime + dt;
+            sleepTime = std::min(sleepTime, body.sleepTime);
+        }
+        if (island.pinned || sleepTime < PHYSICS_SLEEP_TIME) return;
+
+        int index;
+        if (mFreeSleepingIslands.empty())
+        {
+            index = (int)mSleepingIslands.size();
+            mSleepingIslands.push_back({});
+        }
+        else
+        {
+            index = mFreeSleepingIslands.back();
+            mFreeSleepingIslands.pop_back();
+        }
+
+        // Its contacts are kept for warm starting when it wakes
+        SleepingIsland& sleeping = mSleepingIslands[index];
+        sleeping.bodies.assign(bodies, bodies + island.bodyCount);
+        sleeping.contacts.clear();
+        for (int i = 0; i < island.contactCount; i++)
+            sleeping.contacts.push_back(mContacts[mIslandContacts[island.firstContact + i]]);
+        sleeping.alive = true;
+        mSleepingCount++;
+
+        for (int id : sleeping.bodies)
+        {
+            PhysicsBody& body = mBodies[id];
+            body.sleepIsland = index;
+            body.rb.vel = { 0.0f, 0.0f };
+        }
+    }
+
+    void WakeIsland(int index)
+    {
+        SleepingIsland& sleeping = mSleepingIslands[index];
+        if (!sleeping.alive) return;
+
+        for (int id : sleeping.bodies)
+        {
+            mBodies[id].sleepIsland = -1;
+            mBodies[id].sleepTime = 0.0f;
+        }
+        mWokenContacts.insert(mWokenContacts.end(), sleeping.contacts.begin(), sleeping.contacts.end());
+        sleeping.alive = false;
+        mFreeSleepingIslands.push_back(index);
+        mSleepingCount--;
+    }
+
+    Vector2 RelativeVelocity(const ContactManifold& contact) const
+    {
+        const Vector2 velocityB = contact.b >= 0 ? mBodies[contact.b].rb.vel : Vector2{ 0.0f, 0.0f };
+        return velocityB - mBodies[contact.a].rb.vel;
+    }
+
+    // Bodies with invMass 0 can be in several islands at once and are never written, other threads may be
+    // reading them
+    void ApplyImpulse(const ContactManifold& contact, Vector2 impulse)
+    {
+        Rigidbody& a = mBodies[contact.a].rb;
+        if (a.invMass > 0.0f) a.vel = a.vel - impulse * a.invMass;
+        if (contact.b >= 0)
+        {
+            Rigidbody& b = mBodies[contact.b].rb;
+            if (b.invMass > 0.0f) b.vel = b.vel + impulse * b.invMass;
+        }
+    }
+
+    void PrepareContact(ContactManifold& contact, float dt)
+    {
+        const Rigidbody& a = mBodies[contact.a].rb;
+        const Rigidbody* b = contact.b >= 0 ? &mBodies[contact.b].rb : nullptr;
+        const float invMass = a.invMass + (b != nullptr ? b->invMass : 0.0f);
+        contact.mass = invMass > 0.0f ? 1.0f / invMass : 0.0f;
+        contact.friction = b != nullptr ? sqrtf(a.friction * b->friction) : a.friction;
+        contact.restitution = b != nullptr ? std::max(a.restitution, b->restitution) : a.restitution;
+
+        // Let a gap close but no more, and bounce if they'll meet this step. Closing speeds are negative.
+        const float speed = Dot(RelativeVelocity(contact), contact.normal);
+        contact.bias = std::min(contact.penetration, 0.0f) / dt;
+        if (speed < -PHYSICS_RESTITUTION_THRESHOLD && contact.penetration - speed * dt > 0.0f)
+            contact.bias = std::max(contact.bias, -contact.restitution * speed);
+        contact.pushBias = PHYSICS_BAUMGARTE / dt * std::max(contact.penetration - PHYSICS_SLOP, 0.0f);
+        contact.pushImpulse = 0.0f;
+
+        if (mWarmStarting)
+        {
+            const Vector2 tangent{ -contact.normal.y, contact.normal.x };
+            ApplyImpulse(contact, contact.normal * contact.normalImpulse + tangent * contact.tangentImpulse);
+        }
+        else
+        {
+            contact.normalImpulse = 0.0f;
+            contact.tangentImpulse = 0.0f;
+        }
+    }
+
+    // Clamps the accumulated impulses rather than each pass' so later passes can take back what earlier
+    // ones overdid
+    void SolveContact(ContactManifold& contact)
+    {
+        const float speed = Dot(RelativeVelocity(contact), contact.normal);
+        const float normalImpulse = std::max(contact.normalImpulse + contact.mass * (contact.bias - speed), 0.0f);
+        ApplyImpulse(contact, contact.normal * (normalImpulse - contact.normalImpulse));
+        contact.normalImpulse = normalImpulse;
+
+        const Vector2 tangent{ -contact.normal.y, contact.normal.x };
+        const float sliding = Dot(RelativeVelocity(contact), tangent);
+        const float limit = contact.friction * contact.normalImpulse;
+        const float tangentImpulse = Clamp(contact.tangentImpulse - contact.mass * sliding, -limit, limit);
+        ApplyImpulse(contact, tangent * (tangentImpulse - contact.tangentImpulse));
+        contact.tangentImpulse = tangentImpulse;
+    }
+
+    // Position correction, solved like the normal impulse but on the push velocities
+    void SolvePush(ContactManifold& contact)
+    {
+        if (contact.pushBias <= 0.0f) return;
+
+        PhysicsBody& a = mBodies[contact.a];
+        PhysicsBody* b = contact.b >= 0 ? &mBodies[contact.b] : nullptr;
+        const Vector2 relative = (b != nullptr ? b->push : Vector2{ 0.0f, 0.0f }) - a.push;
+        const float speed = Dot(relative, contact.normal);
+        const float pushImpulse = std::max(contact.pushImpulse + contact.mass * (contact.pushBias - speed), 0.0f);
+        const Vector2 impulse = contact.normal * (pushImpulse - contact.pushImpulse);
+        contact.pushImpulse = pushImpulse;
+
+        if (a.rb.invMass > 0.0f) a.push = a.push - impulse * a.rb.invMass;
+        if (b != nullptr && b->rb.invMass > 0.0f) b->push = b->push + impulse * b->rb.invMass;
+    }
+
+    std::vector<PhysicsBody> mBodies;
+    std::vector<int> mFreeIds;
+    std::vector<int> mRemovedIds;           // freed by the next Step
+    SweepAndPrune mBroadphase;
+    std::vector<int> mProxyBodies;          // broadphase proxy -> body id
+
+    std::vector<ContactManifold> mContacts;
+    std::vector<ContactManifold> mPrevious;
+    std::unordered_map<uint64_t, int> mPreviousIndex;   // contact key -> index into mPrevious
+    std::vector<int> mObstacleIds;
+    unsigned int mObstacleVersion = 0;
+
+    std::vector<PhysicsIsland> mIslands;    // awake islands as of the last Step
+    std::vector<int> mIslandBodies;
+    std::vector<int> mIslandContacts;       // into mContacts
+    std::vector<int> mParents;              // union-find scratch
+    std::vector<int> mBodyIslands;          // body id -> index into mIslands, -1 for the rest
+    std::vector<int> mIslandOrder;          // largest first
+    std::vector<uint64_t> mColourMasks;     // colouring scratch, colours each body's contacts already use
+    std::vector<int> mContactColours;
+    std::vector<int> mColourScratch;
+    std::vector<int> mColourStarts;         // into the split island's contacts, PHYSICS_MAX_COLOURS + 2 entries
+    std::vector<SleepingIsland> mSleepingIslands;
+    std::vector<int> mFreeSleepingIslands;
+    std::vector<ContactManifold> mWokenContacts;    // moved into mPrevious by the next Step
+    int mSleepingCount = 0;
+
+    int mIterations = PHYSICS_ITERATIONS;
+    bool mWarmStarting = true;
+};
@@ -0,0 +1,549 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "ThreadPool.h"
+#include "VirtualFileSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Bump whenever encoding or layout changes, stale caches are re-imported
+#define TEXTURE_CACHE_VERSION 2
+#define TEXTURE_CACHE_EXTENSION ".dds"
+
+// Tag stored in the DDS reserved words so foreign .dds files aren't mistaken for caches
+#define TEXTURE_CACHE_TAG 0x534E5553    // "SUNS"
+
+struct TextureImportOptions
+{
+    bool mipmaps = true;
+    bool srgb = true;           // filter colour in linear light, alpha is always linear
+    bool compress = true;       // BC1 when opaque, BC3 when any alpha, falls back to RGBA8 when a level can't be whole blocks
+};
+
+//----------------------------------------------------------------------------------
+// Mip generation
+//----------------------------------------------------------------------------------
+
+float SrgbToLinear(unsigned char value)
+{
+    struct Table
+    {
+        float values[256];
+        Table()
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                float c = i / 255.0f;
+                values[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+            }
+        }
+    };
+    static const Table table;
+    return table.values[value];
+}
+
+unsigned char LinearToSrgb(float value)
+{
+    value = Clamp(value, 0.0f, 1.0f);
+    float c = value <= 0.0031308f ? value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+    return (unsigned char)(c * 255.0f + 0.5f);
+}
+
+// Halves an RGBA level with a separable [1 3 3 1] / 8 tent (bilinear-equivalent support, less aliasing than a box)
+void DownsampleLevel(const std::vector<float>& source, int width, int height,
+    std::vector<float>& result, int& resultWidth, int& resultHeight, ThreadPool& pool)
+{
+    resultWidth = std::max(width / 2, 1);
+    resultHeight = std::max(height / 2, 1);
+
+    static const float weights[4] = { 1.0f / 8.0f, 3.0f / 8.0f, 3.0f / 8.0f, 1.0f / 8.0f };
+
+    // Horizontal pass into a half-width, full-height buffer, then vertical
+    std::vector<float> rows((size_t)resultWidth * height * 4);
+    ParallelFor(pool, height, 16, [&](size_t begin, size_t end)
+    {
+        for (size_t y = begin; y < end; y++)
+        {
+            for (int x = 0; x < resultWidth; x++)
+            {
+                float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                for (int k = 0; k < 4; k++)
+                {
+                    int sx = std::min(std::max(x * 2 - 1 + k, 0), width - 1);
+                    const float* texel = &source[(y * width + sx) * 4];
+                    for (int c = 0; c < 4; c++)
+                        sum[c] += texel[c] * weights[k];
+                }
+                memcpy(&rows[(y * resultWidth + x) * 4], sum, sizeof(sum));
+            }
+        }
+    });
+
+    result.assign((size_t)resultWidth * resultHeight * 4, 0.0f);
+    ParallelFor(pool, resultHeight, 16, [&](size_t begin, size_t end)
+    {
+        for (size_t y = begin; y < end; y++)
+        {
+            for (int x = 0; x < resultWidth; x++)
+            {
+                float* texel = &result[(y * resultWidth + x) * 4];
+                for (int k = 0; k < 4; k++)
+                {
+                    int sy = std::min(std::max((int)y * 2 - 1 + k, 0), height - 1);
+                    const float* row = &rows[((size_t)sy * resultWidth + x) * 4];
+                    for (int c = 0; c < 4; c++)
+                        texel[c] += row[c] * weights[k];
+                }
+            }
+        }
+    });
+}
+
+//----------------------------------------------------------------------------------
+// Block compression
+//----------------------------------------------------------------------------------
+
+uint16_t PackRgb565(const float color[3])
+{
+    int r = (int)(Clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+    int g = (int)(Clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+    int b = (int)(Clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+void UnpackRgb565(uint16_t packed, float color[3])
+{
+    color[0] = (float)(((packed >> 11) & 31) * 255 / 31);
+    color[1] = (float)(((packed >> 5) & 63) * 255 / 63);
+    color[2] = (float)((packed & 31) * 255 / 31);
+}
+
+// Encodes 16 RGBA texels into an 8-byte BC1 colour block, always in 4-colour mode.
+// Endpoints are the extremes along the block's principal axis, pulled in slightly to cut quantisation error.
+void EncodeBc1Block(const unsigned char* texels, unsigned char* block)
+{
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++)
+    {
+        for (int c = 0; c < 3; c++)
+            mean[c] += texels[i * 4 + c] / 16.0f;
+    }
+
+    float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++)
+    {
+        float r = texels[i * 4] - mean[0], g = texels[i * 4 + 1] - mean[1], b = texels[i * 4 + 2] - mean[2];
+        covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+        covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+    }
+
+    // Power iteration for the dominant eigenvector
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+        float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+        float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+        float length = fmaxf(fabsf(x), fmaxf(fabsf(y), fabsf(z)));
+        if (length <= 0.0f) break;
+        axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+    }
+
+    float minProjection = FLT_MAX, maxProjection = -FLT_MAX;
+    for (int i = 0; i < 16; i++)
+    {
+        float projection = (texels[i * 4] - mean[0]) * axis[0] + (texels[i * 4 + 1] - mean[1]) * axis[1] + (texels[i * 4 + 2] - mean[2]) * axis[2];
+        minProjection = fminf(minProjection, projection);
+        maxProjection = fmaxf(maxProjection, projection);
+    }
+
+    float lengthSqr = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float inset = (maxProjection - minProjection) / 32.0f;
+    float endpoints[2][3];
+    for (int c = 0; c < 3; c++)
+    {
+        endpoints[0][c] = mean[c] + axis[c] * (maxProjection - inset) / lengthSqr;
+        endpoints[1][c] = mean[c] + axis[c] * (minProjection + inset) / lengthSqr;
+    }
+
+    uint16_t color0 = PackRgb565(endpoints[0]);
+    uint16_t color1 = PackRgb565(endpoints[1]);
+    if (color0 < color1) std::swap(color0, color1);
+
+    uint32_t indices = 0;
+    if (color0 != color1)
+    {
+        float palette[4][3];
+        UnpackRgb565(color0, palette[0]);
+        UnpackRgb565(color1, palette[1]);
+        for (int c = 0; c < 3; c++)
+        {
+            palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+            palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            float bestDistance = FLT_MAX;
+            for (int p = 0; p < 4; p++)
+            {
+                float dr = texels[i * 4] - palette[p][0], dg = texels[i * 4 + 1] - palette[p][1], db = texels[i * 4 + 2] - palette[p][2];
+                float distance = dr * dr + dg * dg + db * db;
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (uint32_t)best << (i * 2);
+        }
+    }
+
+    memcpy(block, &color0, 2);
+    memcpy(block + 2, &color1, 2);
+    memcpy(block + 4, &indices, 4);
+}
+
+// Encodes the alpha of 16 RGBA texels into an 8-byte BC3 alpha block (8-value interpolation mode)
+void EncodeBc3AlphaBlock(const unsigned char* texels, unsigned char* block)
+{
+    int alpha0 = 0, alpha1 = 255;
+    for (int i = 0; i < 16; i++)
+    {
+        alpha0 = std::max(alpha0, (int)texels[i * 4 + 3]);
+        alpha1 = std::min(alpha1, (int)texels[i * 4 + 3]);
+    }
+
+    block[0] = (unsigned char)alpha0;
+    block[1] = (unsigned char)alpha1;
+
+    uint64_t indices = 0;
+    if (alpha0 != alpha1)
+    {
+        // Palette order for alpha0 > alpha1: a0, a1, then six steps from a0 to a1
+        int palette[8] = { alpha0, alpha1 };
+        for (int p = 1; p <= 6; p++)
+            palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            int bestDistance = 256;
+            for (int p = 0; p < 8; p++)
+            {
+                int distance = abs(texels[i * 4 + 3] - palette[p]);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (uint64_t)best << (i * 3);
+        }
+    }
+
+    for (int b = 0; b < 6; b++)
+        block[2 + b] = (unsigned char)(indices >> (b * 8));
+}
+
+// raylib sizes a compressed level as width * height texels unless both sides are under 4, where it takes one
+// block, so every level of a compressed chain has to be one or the other
+bool CompressibleLevel(int width, int height)
+{
+    return (width % 4 == 0 && height % 4 == 0) || (width < 4 && height < 4);
+}
+
+// Compresses an RGBA8 level (CompressibleLevel) into BC1 or BC3 blocks, levels under 4x4 are one block with the
+// edge texels repeated into the padding
+std::vector<unsigned char> CompressLevel(const unsigned char* pixels, int width, int height, bool alpha, ThreadPool& pool)
+{
+    const int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    const int blockBytes = alpha ? 16 : 8;
+    std::vector<unsigned char> blocks((size_t)blocksX * blocksY * blockBytes);
+
+    ParallelFor(pool, blocksY, 4, [&](size_t begin, size_t end)
+    {
+        unsigned char texels[16 * 4];
+        for (size_t by = begin; by < end; by++)
+        {
+            for (int bx = 0; bx < blocksX; bx++)
+            {
+                for (int y = 0; y < 4; y++)
+                {
+                    const int sy = std::min((int)by * 4 + y, height - 1);
+                    for (int x = 0; x < 4; x++)
+                    {
+                        const int sx = std::min(bx * 4 + x, width - 1);
+                        memcpy(&texels[(y * 4 + x) * 4], &pixels[(sy * width + sx) * 4], 4);
+                    }
+                }
+
+                unsigned char* block = &blocks[(by * blocksX + bx) * blockBytes];
+                if (alpha)
+                {
+                    EncodeBc3AlphaBlock(texels, block);
+                    EncodeBc1Block(texels, block + 8);
+                }
+                else EncodeBc1Block(texels, block);
+            }
+        }
+    });
+
+    return blocks;
+}
+
+//----------------------------------------------------------------------------------
+// DDS container
+//----------------------------------------------------------------------------------
+
+struct DdsPixelFormat
+{
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rBitMask, gBitMask, bBitMask, aBitMask;
+};
+
+struct DdsHeader
+{
+    uint32_t magic;             // "DDS "
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11];     // [0] tag, [1] version, [2..3] source mod time, [4] import flags
+    DdsPixelFormat format;
+    uint32_t caps, caps2, caps3, caps4;
+    uint32_t reserved2;
+};
+
+uint32_t TextureImportFlags(const TextureImportOptions& options)
+{
+    return (options.mipmaps ? 1u : 0u) | (options.srgb ? 2u : 0u) | (options.compress ? 4u : 0u);
+}
+
+// Decodes, builds the mip chain and encodes a texture, returning the complete DDS file
+bool ImportTexture(const char* fileName, long sourceModTime, const TextureImportOptions& options,
+    std::vector<unsigned char>& dds, ThreadPool& pool = DefaultThreadPool())
+{
+    Image image = LoadImage(fileName);
+    if (image.data == nullptr) return false;
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    const int width = image.width, height = image.height;
+    const unsigned char* pixels = (const unsigned char*)image.data;
+
+    bool alpha = false;
+    for (int i = 0; i < width * height && !alpha; i++)
+        alpha = pixels[i * 4 + 3] < 255;
+
+    // Block compression needs every level to be whole blocks, down to 1x1 when mipmapped so the chain is complete
+    bool compress = options.compress && CompressibleLevel(width, height);
+    for (int w = width, h = height; compress && options.mipmaps && (w > 1 || h > 1);)
+    {
+        w = std::max(w / 2, 1);
+        h = std::max(h / 2, 1);
+        compress = CompressibleLevel(w, h);
+    }
+    std::vector<std::vector<unsigned char>> levels;
+    levels.emplace_back(pixels, pixels + (size_t)width * height * 4);
+
+    std::vector<float> level((size_t)width * height * 4);
+    for (size_t i = 0; i < level.size(); i++)
+        level[i] = (options.srgb && i % 4 != 3) ? SrgbToLinear(pixels[i]) : pixels[i] / 255.0f;
+    UnloadImage(image);
+
+    int levelWidth = width, levelHeight = height;
+    while (options.mipmaps && (levelWidth > 1 || levelHeight > 1))
+    {
+        std::vector<float> next;
+        DownsampleLevel(level, levelWidth, levelHeight, next, levelWidth, levelHeight, pool);
+        level.swap(next);
+
+        std::vector<unsigned char> encoded(level.size());
+        for (size_t i = 0; i < level.size(); i++)
+            encoded[i] = (options.srgb && i % 4 != 3) ? LinearToSrgb(level[i]) : (unsigned char)(Clamp(level[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+        levels.push_back(std::move(encoded));
+    }
+
+    DdsHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(&header.magic, "DDS ", 4);
+    header.size = 124;
+    header.flags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;     // caps, height, width, pixel format, mip count
+    header.height = (uint32_t)height;
+    header.width = (uint32_t)width;
+    header.mipMapCount = (uint32_t)levels.size();
+    header.reserved1[0] = TEXTURE_CACHE_TAG;
+    header.reserved1[1] = TEXTURE_CACHE_VERSION;
+    header.reserved1[2] = (uint32_t)((uint64_t)sourceModTime & 0xFFFFFFFFu);
+    header.reserved1[3] = (uint32_t)((uint64_t)sourceModTime >> 32);
+    header.reserved1[4] = TextureImportFlags(options);
+    header.format.size = 32;
+    header.caps = 0x1000 | (levels.size() > 1 ? 0x400008u : 0u);  // texture, mipmap | complex
+
+    if (compress)
+    {
+        header.flags |= 0x80000;    // linear size
+        header.format.flags = 0x4;  // fourCC
+        memcpy(&header.format.fourCC, alpha ? "DXT5" : "DXT1", 4);
+        header.pitchOrLinearSize = (uint32_t)((width + 3) / 4) * ((height + 3) / 4) * (alpha ? 16 : 8);
+    }
+    else
+    {
+        header.flags |= 0x8;        // pitch
+        header.format.flags = 0x40 | 0x1;   // rgb, alpha pixels
+        header.format.rgbBitCount = 32;
+        header.format.rBitMask = 0x000000FF;
+        header.format.gBitMask = 0x0000FF00;
+        header.format.bBitMask = 0x00FF0000;
+        header.format.aBitMask = 0xFF000000;
+        header.pitchOrLinearSize = (uint32_t)width * 4;
+    }
+
+    dds.assign((const unsigned char*)&header, (const unsigned char*)&header + sizeof(header));
+    levelWidth = width;
+    levelHeight = height;
+    for (const std::vector<unsigned char>& data : levels)
+    {
+        if (compress)
+        {
+            std::vector<unsigned char> blocks = CompressLevel(data.data(), levelWidth, levelHeight, alpha, pool);
+            dds.insert(dds.end(), blocks.begin(), blocks.end());
+        }
+        else dds.insert(dds.end(), data.begin(), data.end());
+
+        levelWidth = std::max(levelWidth / 2, 1);
+        levelHeight = std::max(levelHeight / 2, 1);
+    }
+
+    return true;
+}
+
+// Size of a mip chain as raylib lays it out in Image.data
+size_t TextureChainBytes(int width, int height, int mipmaps, int format)
+{
+    size_t bytes = 0;
+    for (int i = 0; i < mipmaps; i++)
+    {
+        if (format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) bytes += (size_t)width * height * 4;
+        else bytes += (size_t)std::max(width / 4, 1) * std::max(height / 4, 1) * (format == PIXELFORMAT_COMPRESSED_DXT1_RGB ? 8 : 16);
+        width = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+    }
+    return bytes;
+}
+
+// Turns a cache file's bytes into an Image in place, taking ownership of data (allocated by LoadFileData).
+// Fails if the file isn't one of our caches, is stale or was imported with different options.
+bool ParseTextureCache(unsigned char* data, int size, long sourceModTime, const TextureImportOptions& options, Image& image)
+{
+    if (data == nullptr || size < (int)sizeof(DdsHeader)) return false;
+
+    DdsHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(&header.magic, "DDS ", 4) != 0 || header.reserved1[0] != TEXTURE_CACHE_TAG ||
+        header.reserved1[1] != TEXTURE_CACHE_VERSION || header.reserved1[4] != TextureImportFlags(options)) return false;
+
+    uint64_t cachedModTime = (uint64_t)header.reserved1[2] | ((uint64_t)header.reserved1[3] << 32);
+    if (sourceModTime != 0 && cachedModTime != (uint64_t)sourceModTime) return false;
+
+    int format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    if (header.format.flags & 0x4)
+    {
+        if (memcmp(&header.format.fourCC, "DXT1", 4) == 0) format = PIXELFORMAT_COMPRESSED_DXT1_RGB;
+        else if (memcmp(&header.format.fourCC, "DXT5", 4) == 0) format = PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+        else return false;
+    }
+
+    const size_t chainBytes = TextureChainBytes((int)header.width, (int)header.height, (int)header.mipMapCount, format);
+    if (header.mipMapCount == 0 || sizeof(DdsHeader) + chainBytes > (size_t)size) return false;
+
+    // Slide the chain to the front so UnloadImage can free the buffer
+    memmove(data, data + sizeof(DdsHeader), chainBytes);
+
+    image.data = data;
+    image.width = (int)header.width;
+    image.height = (int)header.height;
+    image.mipmaps = (int)header.mipMapCount;
+    image.format = format;
+    return true;
+}
+
+bool SaveTextureCache(const char* fileName, const std::vector<unsigned char>& dds)
+{
+    // Write then rename so a crash never leaves a truncated cache behind
+    std::string tempName = std::string(fileName) + ".tmp";
+    std::ofstream outFile(tempName, std::ios::binary | std::ios::trunc);
+    outFile.write((const char*)dds.data(), dds.size());
+    outFile.close();
+    if (!outFile)
+    {
+        std::remove(tempName.c_str());
+        return false;
+    }
+
+    std::remove(fileName);
+    return std::rename(tempName.c_str(), fileName) == 0;
+}
+
+// Loads an image with its full mip chain through <fileName>.dds, importing the source when the cache is
+// missing or stale, or always with reimport since mod times are whole seconds. CPU only, safe to call off the
+// main thread. Returns an empty image on failure.
+Image LoadImageCached(const char* fileName, const TextureImportOptions& options = TextureImportOptions(),
+    bool reimport = false)
+{
+    std::string cacheName = std::string(fileName) + TEXTURE_CACHE_EXTENSION;
+    long sourceModTime = GetAssetFileModTime(fileName);
+
+    Image image = { 0 };
+    int size = 0;
+    unsigned char* data = nullptr;
+    if (!reimport && AssetFileExists(cacheName.c_str())) data = LoadFileData(cacheName.c_str(), &size);
+    if (ParseTextureCache(data, size, sourceModTime, options, image)) return image;
+    UnloadFileData(data);
+
+    double start = GetTime();
+    std::vector<unsigned char> dds;
+    if (!ImportTexture(fileName, sourceModTime, options, dds)) return image;
+
+    TraceLog(LOG_INFO, "TEXTURE: [%s] Imported %i mip levels, %i bytes, in %.2f ms", fileName,
+        (int)((const DdsHeader*)dds.data())->mipMapCount, (int)dds.size(), (GetTime() - start) * 1000.0);
+
+    if (!SaveTextureCache(cacheName.c_str(), dds))
+        TraceLog(LOG_WARNING, "TEXTURE: [%s] Failed to write texture cache", cacheName.c_str());
+
+    data = (unsigned char*)MemAlloc((unsigned int)dds.size());
+    memcpy(data, dds.data(), dds.size());
+    ParseTextureCache(data, (int)dds.size(), sourceModTime, options, image);
+    return image;
+}
+
+// Uploads an image from LoadImageCached and releases it, must run on the thread owning the GL context
+Texture2D UploadImageCached(Image image)
+{
+    Texture2D texture = LoadTextureFromImage(image);
+    if (texture.mipmaps > 1) SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+    UnloadImage(image);
+    return texture;
+}
+
+// Loads a texture through its cache and uploads every level, trilinear filtered when mipmapped
+Texture2D LoadTextureCached(const char* fileName, const TextureImportOptions& options = TextureImportOptions())
+{
+    Image image = LoadImageCached(fileName, options);
+    if (image.data == nullptr) return LoadTexture(fileName);
+    return UploadImageCached(image);
+}
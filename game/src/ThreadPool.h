@@ -0,0 +1,122 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads pulling tasks from a shared queue
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threadCount = 0)
+    {
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        for (size_t i = 0; i < threadCount; i++)
+            mWorkers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWake.notify_all();
+
+        for (std::thread& worker : mWorkers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t Size() const
+    {
+        return mWorkers.size();
+    }
+
+    void Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.push_back(std::move(task));
+        }
+        mWake.notify_one();
+    }
+
+private:
+    void WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWake.wait(lock, [this] { return mStopping || !mTasks.empty(); });
+                if (mStopping && mTasks.empty()) return;
+
+                task = std::move(mTasks.front());
+                mTasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> mWorkers;
+    std::deque<std::function<void()>> mTasks;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    bool mStopping = false;
+};
+
+// Pool shared by loaders and systems that don't own one
+ThreadPool& DefaultThreadPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+// Splits [0, count) into contiguous batches of at least minBatch and runs fn(begin, end) on each.
+// The calling thread works on the first batch and returns once every batch has finished.
+void ParallelFor(ThreadPool& pool, size_t count, size_t minBatch,
+    const std::function<void(size_t, size_t)>& fn)
+{
+    if (count == 0) return;
+
+    minBatch = std::max<size_t>(minBatch, 1);
+    size_t batchCount = std::min((count + minBatch - 1) / minBatch, pool.Size() + 1);
+    size_t batchSize = (count + batchCount - 1) / batchCount;
+    if (batchCount <= 1)
+    {
+        fn(0, count);
+        return;
+    }
+
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining = batchCount - 1;
+
+    for (size_t batch = 1; batch < batchCount; batch++)
+    {
+        size_t begin = batch * batchSize;
+        size_t end = std::min(begin + batchSize, count);
+        pool.Submit([&, begin, end]
+        {
+            if (begin < end) fn(begin, end);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0) done.notify_one();
+        });
+    }
+
+    fn(0, std::min(batchSize, count));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&remaining] { return remaining == 0; });
+}
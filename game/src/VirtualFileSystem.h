@@ -0,0 +1,222 @@
+#pragma once
+#include "raylib.h"
+#include "AssetPack.h"
+#include "Lz4.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Loose files on disk take precedence over packed ones so assets can be edited without repacking.
+// Shipping builds can define this as 0 to skip the per-file open attempt.
+#ifndef VFS_LOOSE_OVERRIDE
+#define VFS_LOOSE_OVERRIDE 1
+#endif
+
+// Read-only file contents, either a mapped loose file, a view into a mounted pack or a decompressed copy
+struct AssetFile
+{
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    MappedFile mapping;
+    unsigned char* owned = nullptr;
+};
+
+struct MountedPack
+{
+    std::string mountPoint;     // normalised, with a trailing separator
+    MappedFile file;
+    const PackEntry* entries = nullptr;
+    uint32_t entryCount = 0;
+    const char* names = nullptr;
+};
+
+// Packs are mounted before loading starts and are read-only afterwards, so lookups need no locking
+std::vector<MountedPack>& MountedPacks()
+{
+    static std::vector<MountedPack> packs;
+    return packs;
+}
+
+// Finds the entry for fileName in any mounted pack, most recently mounted first
+const PackEntry* FindPackEntry(const char* fileName, const MountedPack** pack = nullptr)
+{
+    std::vector<MountedPack>& packs = MountedPacks();
+    if (packs.empty()) return nullptr;
+
+    const std::string path = NormalizePath(fileName);
+    for (size_t p = packs.size(); p-- > 0;)
+    {
+        const MountedPack& mounted = packs[p];
+        if (path.compare(0, mounted.mountPoint.size(), mounted.mountPoint) != 0) continue;
+
+        const char* name = path.c_str() + mounted.mountPoint.size();
+        const size_t length = path.size() - mounted.mountPoint.size();
+        const uint64_t hash = HashPath(name, length);
+
+        const PackEntry* end = mounted.entries + mounted.entryCount;
+        const PackEntry* entry = std::lower_bound(mounted.entries, end, hash,
+            [](const PackEntry& e, uint64_t h) { return e.hash < h; });
+        for (; entry != end && entry->hash == hash; entry++)
+        {
+            if (strcmp(mounted.names + entry->nameOffset, name) != 0) continue;
+            if (pack != nullptr) *pack = &mounted;
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+bool AssetFileExists(const char* fileName)
+{
+#if VFS_LOOSE_OVERRIDE
+    if (FileExists(fileName)) return true;
+#endif
+    return FindPackEntry(fileName) != nullptr;
+}
+
+// Modification time of the loose file, or of the file when it was packed, 0 when missing
+long GetAssetFileModTime(const char* fileName)
+{
+#if VFS_LOOSE_OVERRIDE
+    if (FileExists(fileName)) return GetFileModTime(fileName);
+#endif
+    const PackEntry* entry = FindPackEntry(fileName);
+    return entry != nullptr ? (long)entry->modTime : 0;
+}
+
+// Opens a file through the loose override and mounted packs. Stored entries are zero-copy views into the pack.
+// Returns an empty file (data == nullptr) when missing.
+AssetFile LoadAssetFile(const char* fileName)
+{
+    AssetFile file;
+#if VFS_LOOSE_OVERRIDE
+    file.mapping = LoadMappedFile(fileName);
+    if (file.mapping.data != nullptr)
+    {
+        file.data = file.mapping.data;
+        file.size = file.mapping.size;
+        return file;
+    }
+#endif
+
+    const MountedPack* pack = nullptr;
+    const PackEntry* entry = FindPackEntry(fileName, &pack);
+    if (entry == nullptr) return file;
+
+    const unsigned char* stored = pack->file.data + entry->offset;
+    if (entry->compression == PACK_STORED)
+    {
+        file.data = stored;
+        file.size = (size_t)entry->size;
+        return file;
+    }
+
+    file.owned = (unsigned char*)MemAlloc((unsigned int)entry->originalSize);
+    if (!Lz4Decompress(stored, (size_t)entry->size, file.owned, (size_t)entry->originalSize))
+    {
+        TraceLog(LOG_WARNING, "VFS: [%s] Corrupt pack entry", fileName);
+        MemFree(file.owned);
+        file.owned = nullptr;
+        return file;
+    }
+    file.data = file.owned;
+    file.size = (size_t)entry->originalSize;
+    return file;
+}
+
+void UnloadAssetFile(AssetFile& file)
+{
+    UnloadMappedFile(file.mapping);
+    if (file.owned != nullptr) MemFree(file.owned);
+    file = AssetFile();
+}
+
+// raylib loaders (images, audio, models) go through these once a pack is mounted
+unsigned char* LoadFileDataVfs(const char* fileName, int* dataSize)
+{
+    *dataSize = 0;
+    AssetFile file = LoadAssetFile(fileName);
+    if (file.data == nullptr)
+    {
+        TraceLog(LOG_WARNING, "VFS: [%s] Failed to open file", fileName);
+        return nullptr;
+    }
+
+    unsigned char* data = (unsigned char*)MemAlloc((unsigned int)file.size);
+    memcpy(data, file.data, file.size);
+    *dataSize = (int)file.size;
+    UnloadAssetFile(file);
+    return data;
+}
+
+char* LoadFileTextVfs(const char* fileName)
+{
+    AssetFile file = LoadAssetFile(fileName);
+    if (file.data == nullptr)
+    {
+        TraceLog(LOG_WARNING, "VFS: [%s] Failed to open text file", fileName);
+        return nullptr;
+    }
+
+    char* text = (char*)MemAlloc((unsigned int)file.size + 1);
+    memcpy(text, file.data, file.size);
+    text[file.size] = '\0';
+    UnloadAssetFile(file);
+    return text;
+}
+
+// Serves files under mountPoint from a pack built by BuildPack. Later mounts shadow earlier ones.
+bool MountPack(const char* packFile, const char* mountPoint)
+{
+    MountedPack pack;
+    pack.file = LoadMappedFile(packFile);
+    const unsigned char* data = pack.file.data;
+    const size_t size = pack.file.size;
+
+    const PackHeader* header = (const PackHeader*)data;
+    bool valid = data != nullptr && size >= sizeof(PackHeader) && memcmp(header->magic, "SPAK", 4) == 0 &&
+        header->version == ASSET_PACK_VERSION &&
+        header->namesOffset == sizeof(PackHeader) + (uint64_t)header->entryCount * sizeof(PackEntry) &&
+        header->namesOffset + header->namesSize <= size &&
+        (header->namesSize == 0 || data[header->namesOffset + header->namesSize - 1] == '\0');
+
+    if (valid)
+    {
+        pack.entries = (const PackEntry*)(data + sizeof(PackHeader));
+        pack.entryCount = header->entryCount;
+        pack.names = (const char*)(data + header->namesOffset);
+        for (uint32_t i = 0; i < pack.entryCount && valid; i++)
+        {
+            const PackEntry& entry = pack.entries[i];
+            valid = entry.nameOffset < header->namesSize && entry.offset <= size && entry.size <= size - entry.offset &&
+                (entry.compression == PACK_LZ4 || (entry.compression == PACK_STORED && entry.size == entry.originalSize));
+        }
+    }
+
+    if (!valid)
+    {
+        TraceLog(LOG_WARNING, "VFS: [%s] Not a valid asset pack", packFile);
+        UnloadMappedFile(pack.file);
+        return false;
+    }
+
+    pack.mountPoint = NormalizePath(mountPoint) + "/";
+    MountedPacks().push_back(pack);
+    SetLoadFileDataCallback(LoadFileDataVfs);
+    SetLoadFileTextCallback(LoadFileTextVfs);
+
+    TraceLog(LOG_INFO, "VFS: [%s] Mounted %i files at %s", packFile, (int)pack.entryCount, pack.mountPoint.c_str());
+    return true;
+}
+
+// Unmaps every pack, views handed out by LoadAssetFile must already be released
+void UnmountPacks()
+{
+    for (MountedPack& pack : MountedPacks())
+        UnloadMappedFile(pack.file);
+    MountedPacks().clear();
+    SetLoadFileDataCallback(nullptr);
+    SetLoadFileTextCallback(nullptr);
+}
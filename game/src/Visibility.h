@@ -0,0 +1,245 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "ObstacleGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Rays this far apart (radians) break distance ties between segments that meet at a corner
+#define VISIBILITY_TIE_ANGLE 1e-3f
+
+struct VisibilitySegment
+{
+    Vector2 a;
+    Vector2 b;
+};
+
+// Region seen from origin, a fan of triangles (origin, points[i], points[i + 1])
+struct VisibilityPolygon
+{
+    Vector2 origin{};
+    std::vector<Vector2> points;    // boundary, by increasing angle around origin
+    std::vector<float> angles;      // angle of each point around origin, for lookups
+};
+
+// Adds the parts of an axis-aligned obstacle edge that aren't strictly inside another obstacle. The edge lies on
+// coordinate c of one axis and spans [lo, hi] along the other.
+void AddBoundarySegments(bool horizontal, float c, float lo, float hi, int self, const std::vector<int>& neighbours,
+    const ObstacleGrid& obstacles, std::vector<std::pair<float, float>>& covered, std::vector<VisibilitySegment>& segments)
+{
+    covered.clear();
+    for (int id : neighbours)
+    {
+        if (id == self) continue;
+
+        const Rectangle& r = obstacles.Get(id);
+        const float acrossMin = horizontal ? r.y : r.x;
+        const float acrossMax = horizontal ? r.y + r.height : r.x + r.width;
+        if (c > acrossMin && c < acrossMax)
+            covered.push_back(horizontal ? std::make_pair(r.x, r.x + r.width) : std::make_pair(r.y, r.y + r.height));
+    }
+    std::sort(covered.begin(), covered.end());
+
+    float cursor = lo;
+    auto emit = [&](float from, float to)
+    {
+        if (to <= from) return;
+        segments.push_back(horizontal ? VisibilitySegment{ { from, c }, { to, c } } : VisibilitySegment{ { c, from }, { c, to } });
+    };
+    for (const std::pair<float, float>& interval : covered)
+    {
+        if (interval.first > cursor) emit(cursor, std::min(interval.first, hi));
+        cursor = std::max(cursor, interval.second);
+        if (cursor >= hi) return;
+    }
+    emit(cursor, hi);
+}
+
+// Boundary of the union of obstacles clipped to bounds, plus bounds itself. Hidden edge parts are dropped
+// so no two segments cross, which keeps the sweep order consistent.
+void CollectVisibilitySegments(Rectangle bounds, const ObstacleGrid& obstacles, std::vector<VisibilitySegment>& segments)
+{
+    const float x0 = bounds.x, x1 = bounds.x + bounds.width;
+    const float y0 = bounds.y, y1 = bounds.y + bounds.height;
+    segments.clear();
+    segments.push_back({ { x0, y0 }, { x1, y0 } });
+    segments.push_back({ { x1, y0 }, { x1, y1 } });
+    segments.push_back({ { x1, y1 }, { x0, y1 } });
+    segments.push_back({ { x0, y1 }, { x0, y0 } });
+
+    std::vector<int> ids, neighbours;
+    std::vector<std::pair<float, float>> covered;
+    obstacles.QueryRect(bounds, ids);
+    for (int id : ids)
+    {
+        const Rectangle& r = obstacles.Get(id);
+        if (!CheckCollisionRecs(r, bounds)) continue;
+
+        obstacles.QueryRect(r, neighbours);
+        const float left = std::max(r.x, x0), right = std::min(r.x + r.width, x1);
+        const float top = std::max(r.y, y0), bottom = std::min(r.y + r.height, y1);
+        if (r.y > y0) AddBoundarySegments(true, r.y, left, right, id, neighbours, obstacles, covered, segments);
+        if (r.y + r.height < y1) AddBoundarySegments(true, r.y + r.height, left, right, id, neighbours, obstacles, covered, segments);
+        if (r.x > x0) AddBoundarySegments(false, r.x, top, bottom, id, neighbours, obstacles, covered, segments);
+        if (r.x + r.width < x1) AddBoundarySegments(false, r.x + r.width, top, bottom, id, neighbours, obstacles, covered, segments);
+    }
+}
+
+// Distance from origin along direction to the line through segment
+float RayDistance(Vector2 origin, Vector2 direction, const VisibilitySegment& segment)
+{
+    const Vector2 edge = segment.b - segment.a;
+    const float denominator = Cross(direction, edge);
+    if (fabsf(denominator) < 1e-9f) return std::min(Distance(origin, segment.a), Distance(origin, segment.b));
+    return Cross(segment.a - origin, edge) / denominator;
+}
+
+// Orders open segments by distance along the current sweep ray
+struct VisibilitySweepOrder
+{
+    const std::vector<VisibilitySegment>* segments;
+    Vector2 origin;
+    const float* angle;
+
+    bool operator()(int lhs, int rhs) const
+    {
+        if (lhs == rhs) return false;
+
+        Vector2 direction = Direction(*angle);
+        float l = RayDistance(origin, direction, (*segments)[lhs]);
+        float r = RayDistance(origin, direction, (*segments)[rhs]);
+        if (fabsf(l - r) > 1e-5f * (l + r)) return l < r;
+
+        direction = Direction(*angle + VISIBILITY_TIE_ANGLE);
+        l = RayDistance(origin, direction, (*segments)[lhs]);
+        r = RayDistance(origin, direction, (*segments)[rhs]);
+        if (fabsf(l - r) > 1e-7f * (l + r)) return l < r;
+        return lhs < rhs;
+    }
+};
+
+struct VisibilityEvent
+{
+    float angle;
+    int segment;
+    bool begin;
+};
+
+// Angular sweep over segment endpoints keeping open segments ordered by distance, O(n log n) in the number of
+// obstacles within range of origin. Nothing is visible from inside an obstacle.
+void ComputeVisibilityPolygon(Vector2 origin, float range, const ObstacleGrid& obstacles, VisibilityPolygon& polygon)
+{
+    polygon.origin = origin;
+    polygon.points.clear();
+    polygon.angles.clear();
+
+    std::vector<int> ids;
+    obstacles.QueryRect({ origin.x, origin.y, 0.0f, 0.0f }, ids);
+    for (int id : ids)
+    {
+        const Rectangle& r = obstacles.Get(id);
+        if (origin.x > r.x && origin.x < r.x + r.width && origin.y > r.y && origin.y < r.y + r.height) return;
+    }
+
+    std::vector<VisibilitySegment> segments;
+    CollectVisibilitySegments({ origin.x - range, origin.y - range, range * 2.0f, range * 2.0f }, obstacles, segments);
+
+    // Each segment opens at the endpoint where it starts counter-clockwise and closes at the other
+    std::vector<VisibilityEvent> events;
+    events.reserve(segments.size() * 2);
+    for (int i = 0; i < (int)segments.size(); i++)
+    {
+        const float angleA = Angle(origin, segments[i].a);
+        const float angleB = Angle(origin, segments[i].b);
+        float span = angleB - angleA;
+        if (span > PI) span -= 2.0f * PI;
+        if (span <= -PI) span += 2.0f * PI;
+        if (fabsf(span) < 1e-7f) continue;
+
+        events.push_back({ span > 0.0f ? angleA : angleB, i, true });
+        events.push_back({ span > 0.0f ? angleB : angleA, i, false });
+    }
+    std::sort(events.begin(), events.end(), [](const VisibilityEvent& a, const VisibilityEvent& b)
+    {
+        return a.angle != b.angle ? a.angle < b.angle : (!a.begin && b.begin);
+    });
+
+    float angle = 0.0f;
+    VisibilitySweepOrder order{ &segments, origin, &angle };
+    std::set<int, VisibilitySweepOrder> open(order);
+    std::vector<std::set<int, VisibilitySweepOrder>::iterator> openAt(segments.size());
+    std::vector<bool> isOpen(segments.size(), false);
+
+    // The first pass only opens the segments that straddle the start angle, the second emits the fan
+    float wedgeStart = 0.0f;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (size_t i = 0; i < events.size();)
+        {
+            angle = events[i].angle;
+            const int nearestBefore = open.empty() ? -1 : *open.begin();
+            for (; i < events.size() && events[i].angle == angle; i++)
+            {
+                const VisibilityEvent& event = events[i];
+                if (event.begin && !isOpen[event.segment])
+                    openAt[event.segment] = open.insert(event.segment).first;
+                else if (!event.begin && isOpen[event.segment])
+                    open.erase(openAt[event.segment]);
+                else
+                    continue;
+                isOpen[event.segment] = event.begin;
+            }
+
+            const int nearestAfter = open.empty() ? -1 : *open.begin();
+            if (nearestBefore == nearestAfter) continue;
+
+            if (pass == 1 && nearestBefore >= 0)
+            {
+                const VisibilitySegment& segment = segments[nearestBefore];
+                const Vector2 from = Direction(wedgeStart);
+                const Vector2 to = Direction(angle);
+                polygon.points.push_back(origin + from * RayDistance(origin, from, segment));
+                polygon.points.push_back(origin + to * RayDistance(origin, to, segment));
+            }
+            wedgeStart = angle;
+        }
+    }
+
+    // The first wedge wraps around from the end of the previous pass, move its start to the back
+    if (polygon.points.size() >= 2 && Angle(origin, polygon.points[0]) > Angle(origin, polygon.points[1]))
+        std::rotate(polygon.points.begin(), polygon.points.begin() + 1, polygon.points.end());
+
+    polygon.angles.reserve(polygon.points.size());
+    for (const Vector2& point : polygon.points)
+        polygon.angles.push_back(Angle(origin, point));
+}
+
+// Binary search for the wedge containing point then one edge test, O(log n)
+bool CheckCollisionPointVisibility(Vector2 point, const VisibilityPolygon& polygon)
+{
+    const size_t count = polygon.points.size();
+    if (count < 3) return false;
+
+    const float angle = Angle(polygon.origin, point);
+    const size_t upper = std::upper_bound(polygon.angles.begin(), polygon.angles.end(), angle) - polygon.angles.begin();
+    const Vector2 a = polygon.points[(upper + count - 1) % count];
+    const Vector2 b = polygon.points[upper % count];
+
+    // Inside when on the same side of the boundary edge as the origin
+    const Vector2 edge = b - a;
+    return Cross(edge, point - a) * Cross(edge, polygon.origin - a) >= 0.0f;
+}
+
+void DrawVisibilityPolygon(const VisibilityPolygon& polygon, Color color)
+{
+    const size_t count = polygon.points.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        const Vector2 a = polygon.points[i];
+        const Vector2 b = polygon.points[(i + 1) % count];
+        DrawTriangle(polygon.origin, b, a, color);
+    }
+}
@@ -1,31 +1,83 @@
 #include "rlImGui.h"
 #include "Physics.h"
 #include "Collision.h"
+#include "FastMath.h"
+#include "AssetManager.h"
+#include "AudioMixer.h"
+#include "VirtualFileSystem.h"
+#include "Visibility.h"
+#include "LineOfSight.h"
+#include "OccupancyBitmap.h"
+#include "DistanceField.h"
+#include "Convex.h"
+#include "PhysicsWorld.h"
 
 #include <array>
+#include <cstring>
 #include <vector>
 #include <string>
 #include <iostream>
-#include <fstream>
 
 using namespace std;
 
-int main(void)
+int main(int argc, char** argv)
 {
+    // "--pack [directory] [pack] [--store]" bundles the assets into one archive and exits
+    if (argc > 1 && strcmp(argv[1], "--pack") == 0)
+    {
+        const char* directory = argc > 2 ? argv[2] : "../game/assets";
+        const char* packFile = argc > 3 ? argv[3] : "../game/assets.pak";
+        const bool compress = !(argc > 4 && strcmp(argv[4], "--store") == 0);
+        return BuildPack(directory, packFile, compress) ? 0 : 1;
+    }
+
     const int screenWidth = 1280;
     const int screenHeight = 720;
     InitWindow(screenWidth, screenHeight, "Sunshine");
     rlImGuiSetup(true);
+    InitAudioDevice();
+
+    // Loose files under the assets directory still win over the pack
+    if (FileExists("../game/assets.pak"))
+        MountPack("../game/assets.pak", "../game/assets");
+
+    // Holding the mouse button fires a laser every frame
+    AudioMixer audio;
+
+    // Everything streams in after the first frame, including effect decoding
+    AssetManager assets;
+    AssetHandle laserAsset = assets.RequestEffect(audio, "../game/assets/audio/laser.mp3");
+    MeshImportOptions planeImport;
+    planeImport.quantize = true;
+    AssetHandle obstaclesAsset = assets.RequestObstacles("../game/assets/data/obstacles.txt");
+    AssetHandle planeAsset = assets.RequestModel("../game/assets/models/plane.obj", planeImport);
+    AssetHandle planeTextureAsset = assets.RequestTexture("../game/assets/textures/plane_diffuse.png");
+    assets.WatchForChanges("../game/assets");
 
-    vector<Rectangle> obstacles;
-    std::ifstream inFile("../game/assets/data/obstacles.txt");
-    while (!inFile.eof())
+    // Obstacle edits arrive as diffs and are applied in place
+    ObstacleGrid obstacles;
+    ObstacleDiff obstacleDiff;
+    bool obstaclesSorted = false;
+    LodModel* plane = nullptr;
+    int planeVersion = 0;
+    int planeTextureVersion = 0;
+
+    // Fleet of planes for the 3D view, each picks its own level of detail
+    const int fleetSize = 16;
+    const float fleetSpacing = 60.0f;
+    vector<Vector3> fleet;
+    for (int z = 0; z < fleetSize; z++)
     {
-        Rectangle obstacle;
-        inFile >> obstacle.x >> obstacle.y >> obstacle.width >> obstacle.height;
-        obstacles.push_back(obstacle);
+        for (int x = 0; x < fleetSize; x++)
+            fleet.push_back({ (x - fleetSize * 0.5f) * fleetSpacing, 0.0f, -z * fleetSpacing });
     }
-    inFile.close();
+
+    Camera3D camera{};
+    camera.position = { 0.0f, 120.0f, 200.0f };
+    camera.target = { 0.0f, 0.0f, -300.0f };
+    camera.up = { 0.0f, 1.0f, 0.0f };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
 
     float playerRotation = 0.0f;
     const float playerWidth = 60.0f;
@@ -43,11 +95,86 @@ int main(void)
 
     const Rectangle rectangle{ 1000.0f, 500.0f, 160.0f, 90.0f };
     const Circle circle{ { 1000.0f, 250.0f }, 50.0f };
+    const Vector2 rampPoints[] = { { 700.0f, 650.0f }, { 900.0f, 650.0f }, { 900.0f, 560.0f } };
+    const vector<ConvexPolygon> ramps{ ConvexPolygonFromPoints(rampPoints, 3) };
+
+    // Viewer and target ids for the line of sight cache
+    const int playerId = 0;
+    const int rectangleId = 0;
+    const int circleId = 1;
+    LineOfSightCache lineOfSight;
 
     bool demoGUI = false;
+    bool view3D = false;
+    bool showVisibility = false;
+    VisibilityPolygon visibility;
+    const float probeSpacing = 40.0f;
+    bool showOcclusion = false;
+    OccupancyBitmap occupancy;
+    bool showClearance = false;
+    bool showNeighbours = false;
+    const int neighbourCount = 3;
+    const float neighbourRadius = 150.0f;
+    vector<ObstacleDistance> nearestObstacles;
+    vector<int> overlappingObstacles;
+    vector<int> playerCandidates;
+    DistanceField distanceField;
+    distanceField.Build({ 0.0f, 0.0f, (float)screenWidth, (float)screenHeight }, obstacles);
+
+    // A stack of crates on the floor, the player shoves them around
+    PhysicsWorld physics;
+    Rigidbody floorBody;
+    floorBody.invMass = 0.0f;
+    const float floorHeight = 10.0f;
+    physics.AddBody({ 0.0f, screenHeight - floorHeight, (float)screenWidth, floorHeight }, floorBody);
+    const float crateSize = 40.0f;
+    for (int i = 0; i < 8; i++)
+    {
+        Rigidbody crate;
+        crate.acc = { 0.0f, 980.0f };
+        physics.AddBody({ 840.0f, screenHeight - floorHeight - crateSize * (i + 1), crateSize, crateSize }, crate);
+    }
+    Rigidbody pusher;
+    pusher.invMass = 0.0f;
+    const int playerBodyId = physics.AddBody({ 0.0f, 0.0f, playerWidth, playerHeight }, pusher);
+    bool playerBodyPlaced = false;
     SetTargetFPS(60);
     while (!WindowShouldClose())
     {
+        assets.Update();
+        bool obstaclesChanged = false;
+        while (assets.PollObstacleChanges(obstaclesAsset, obstacleDiff))
+        {
+            ApplyObstacleDiff(obstacles, obstacleDiff);
+            Rectangle changed;
+            if (GetObstacleDiffBounds(obstacleDiff, changed))
+                distanceField.Update(changed, obstacles);
+            obstaclesChanged = true;
+        }
+
+        // Keep neighbouring obstacles together in memory once the level first loads, reload edits stay incremental
+        if (obstaclesChanged && !obstaclesSorted)
+        {
+            obstacles.SortByMorton();
+            obstaclesSorted = true;
+        }
+        if (occupancy.Version() != obstacles.Version())
+            occupancy.Build({ 0.0f, 0.0f, (float)screenWidth, (float)screenHeight }, obstacles);
+
+        // Rebind the texture whenever either half is (re)loaded
+        if (assets.IsReady(planeAsset) && assets.State(planeTextureAsset) != ASSET_LOADING &&
+            (assets.Version(planeAsset) != planeVersion || assets.Version(planeTextureAsset) != planeTextureVersion))
+        {
+            plane = assets.GetModel(planeAsset);
+            planeVersion = assets.Version(planeAsset);
+            planeTextureVersion = assets.Version(planeTextureAsset);
+            if (Texture2D* planeTexture = assets.GetTexture(planeTextureAsset))
+            {
+                for (Model& lod : plane->lods)
+                    SetMaterialTexture(&lod.materials[0], MATERIAL_MAP_DIFFUSE, *planeTexture);
+            }
+        }
+
         float dt = GetFrameTime();
         if (IsKeyDown(KEY_E))
             playerRotation += playerRotationSpeed * dt;
@@ -55,31 +182,141 @@ int main(void)
             playerRotation -= playerRotationSpeed * dt;
 
         const Vector2 playerPosition = GetMousePosition();
-        const Vector2 playerDirection = Direction(playerRotation * DEG2RAD);
+        const Vector2 playerDirection = DirectionFast(playerRotation * DEG2RAD);
         const Vector2 playerEnd = playerPosition + playerDirection * playerRange;
         const Rectangle playerRec{ playerPosition.x, playerPosition.y, playerWidth, playerHeight };
+        const Vector2 playerOrigin{ playerWidth * 0.5f, playerHeight * 0.5f };
+        const OrientedBox playerBox = OrientedBoxFromRec(playerRec, playerOrigin, playerRotation);
+
+        // The player moves the crates as an unpushable box following the mouse, fast enough to get there this step
+        const Rectangle playerBounds = GetOrientedBoxBounds(playerBox);
+        PhysicsBody& playerBody = physics.GetBody(playerBodyId);
+        const float physicsDt = std::min(dt, 1.0f / 30.0f);
+        playerBody.halfExtents = { playerBounds.width * 0.5f, playerBounds.height * 0.5f };
+        if (!playerBodyPlaced || physicsDt <= 0.0f)
+        {
+            playerBody.position = playerBox.center;
+            playerBodyPlaced = true;
+        }
+        playerBody.rb.vel = physicsDt > 0.0f ? (playerBox.center - playerBody.position) / physicsDt : Vector2{ 0.0f, 0.0f };
+        if (IsKeyPressed(KEY_F6)) physics.SetWarmStarting(!physics.WarmStarting());
+        physics.Step(physicsDt, obstacles);
 
         const Vector2 nearestRecPoint = NearestPoint(playerPosition, playerEnd,
             { rectangle.x + rectangle.width * 0.5f, rectangle.y + rectangle.height * 0.5f });
         const Vector2 nearestCirclePoint = NearestPoint(playerPosition, playerEnd, circle.position);
         Vector2 poi;
 
-        const bool collision = NearestIntersection(playerPosition, playerEnd, obstacles, poi);
-        const bool rectangleVisible = IsRectangleVisible(playerPosition, playerEnd, rectangle, obstacles);
-        const bool circleVisible = IsCircleVisible(playerPosition, playerEnd, circle, obstacles);
+        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT))
+            audio.Play(assets.GetEffect(laserAsset), 0.25f, playerPosition.x / screenWidth);
+
+        bool collision = NearestIntersection(playerPosition, playerEnd, obstacles, poi);
+        Vector2 rampPoi;
+        if (NearestIntersection(playerPosition, playerEnd, ramps, rampPoi) &&
+            (!collision || DistanceSqr(playerPosition, rampPoi) < DistanceSqr(playerPosition, poi)))
+        {
+            collision = true;
+            poi = rampPoi;
+        }
+        const bool rectangleVisible = IsRectangleVisible(playerPosition, playerEnd, rectangle, obstacles, lineOfSight, playerId, rectangleId);
+        const bool circleVisible = IsCircleVisible(playerPosition, playerEnd, circle, obstacles, lineOfSight, playerId, circleId);
+        const bool playerColliding = CheckCollisionOBBObstacles(playerBox, obstacles, playerCandidates) ||
+            CheckCollisionOBBRec(playerBox, rectangle) || CheckCollisionOBBCircle(playerBox, circle) ||
+            CheckCollisionConvex(playerBox, ramps[0]);
 
         BeginDrawing();
         ClearBackground(RAYWHITE);
 
+        // Render 3D scene
+        if (IsKeyPressed(KEY_F1)) view3D = !view3D;
+        if (view3D && plane != nullptr)
+        {
+            const Matrix view = LookAt(camera.position, camera.target, camera.up);
+            const Matrix projection = Perspective(camera.fovy * DEG2RAD,
+                (double)screenWidth / (double)screenHeight, 0.01, 1000.0);
+
+            array<int, LOD_MAX_LEVELS> lodCounts{};
+            BeginMode3D(camera);
+            for (const Vector3& position : fleet)
+            {
+                int lod = SelectLod(*plane, Translate(position.x, position.y, position.z), view, projection, screenHeight);
+                DrawModel(plane->lods[lod], position, 1.0f, WHITE);
+                lodCounts[lod]++;
+            }
+            EndMode3D();
+
+            for (int i = 0; i < (int)plane->lods.size(); i++)
+                DrawText(TextFormat("LOD %i: %i", i, lodCounts[i]), 10, 10 + i * (fontSize + 2), fontSize, DARKGRAY);
+        }
+
+        // Render field of view, one sweep then a cheap lookup per probe
+        if (IsKeyPressed(KEY_F2)) showVisibility = !showVisibility;
+        if (showVisibility)
+        {
+            ComputeVisibilityPolygon(playerPosition, playerRange, obstacles, visibility);
+            DrawVisibilityPolygon(visibility, Fade(SKYBLUE, 0.3f));
+            for (float y = probeSpacing * 0.5f; y < screenHeight; y += probeSpacing)
+            {
+                for (float x = probeSpacing * 0.5f; x < screenWidth; x += probeSpacing)
+                    DrawCircleV({ x, y }, 2.0f, CheckCollisionPointVisibility({ x, y }, visibility) ? DARKBLUE : LIGHTGRAY);
+            }
+        }
+
+        // Render coarse line of sight to each probe, orange where only an exact test could tell
+        if (IsKeyPressed(KEY_F3)) showOcclusion = !showOcclusion;
+        if (showOcclusion)
+        {
+            const Color colors[] = { GREEN, RED, ORANGE };
+            for (float y = probeSpacing * 0.5f; y < screenHeight; y += probeSpacing)
+            {
+                for (float x = probeSpacing * 0.5f; x < screenWidth; x += probeSpacing)
+                    DrawCircleV({ x, y }, 3.0f, colors[occupancy.TestSegment(playerPosition, { x, y })]);
+            }
+        }
+
+        // Render clearance around the player and the direction away from the nearest obstacle
+        if (IsKeyPressed(KEY_F4)) showClearance = !showClearance;
+        if (showClearance)
+        {
+            const float clearance = distanceField.Sample(playerPosition);
+            if (clearance > 0.0f)
+                DrawCircleLines(playerPosition.x, playerPosition.y, clearance, DARKGREEN);
+            DrawLineV(playerPosition, playerPosition + distanceField.Gradient(playerPosition) * 40.0f, DARKGREEN);
+        }
+
         // Render player
-        DrawRectanglePro(playerRec, { playerWidth * 0.5f, playerHeight * 0.5f }, playerRotation, PURPLE);
+        DrawRectanglePro(playerRec, playerOrigin, playerRotation, playerColliding ? RED : PURPLE);
         DrawLine(playerPosition.x, playerPosition.y, playerEnd.x, playerEnd.y, BLUE);
         DrawCircleV(playerPosition, 10.0f, BLUE);
 
         // Render geometry
-        for (const Rectangle& obstacle : obstacles)
+        for (const Rectangle& obstacle : obstacles.Rectangles())
             DrawRectangleRec(obstacle, GREEN);
         DrawRectangleRec(rectangle, rectangleVisible ? GREEN : RED);
+        for (const ConvexPolygon& ramp : ramps)
+            DrawConvexPolygon(ramp, GREEN);
+        for (int id = 0; id < (int)physics.Bodies().size(); id++)
+        {
+            if (id != playerBodyId && physics.Contains(id))
+            {
+                const Color crateColor = physics.IsAwake(id) ? ORANGE : BROWN;
+                DrawRectangleRec(physics.GetBounds(id), physics.GetBody(id).rb.invMass > 0.0f ? crateColor : DARKGRAY);
+            }
+        }
+
+        // Render obstacles around the player, overlapping a circle and the few nearest
+        if (IsKeyPressed(KEY_F5)) showNeighbours = !showNeighbours;
+        if (showNeighbours)
+        {
+            obstacles.QueryOverlaps(Circle{ playerPosition, neighbourRadius }, overlappingObstacles);
+            for (int id : overlappingObstacles)
+                DrawRectangleRec(obstacles.Get(id), LIME);
+            DrawCircleLines(playerPosition.x, playerPosition.y, neighbourRadius, LIME);
+
+            obstacles.QueryNearest(playerPosition, neighbourCount, nearestObstacles);
+            for (const ObstacleDistance& nearest : nearestObstacles)
+                DrawLineV(playerPosition, NearestPointRec(playerPosition, obstacles.Get(nearest.id)), MAROON);
+        }
         DrawCircleV(circle.position, circle.radius, circleVisible ? GREEN : RED);
 
         // Render labels
@@ -93,6 +330,10 @@ int main(void)
             DrawCircleV(poi, 10.0f, BLUE);
         }
 
+        DrawText(TextFormat("Voices: %i", audio.ActiveVoices()), 10, screenHeight - fontSize - 10, fontSize, DARKGRAY);
+        DrawText(TextFormat("Warm starting: %s", physics.WarmStarting() ? "on" : "off"), 10, screenHeight - fontSize * 2 - 20,
+            fontSize, DARKGRAY);
+
         // Render GUI
         if (IsKeyPressed(KEY_GRAVE)) demoGUI = !demoGUI;
         if (demoGUI)
@@ -105,6 +346,10 @@ int main(void)
         EndDrawing();
     }
 
+    assets.UnloadAll();
+    UnmountPacks();
+    audio.Close();
+    CloseAudioDevice();
     rlImGuiShutdown();
     CloseWindow();
 
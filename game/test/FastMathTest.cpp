@@ -0,0 +1,210 @@
+// Sweeps FastMath.h against double precision libm and checks the bounds its comments promise. Prints the
+// largest error of every function and exits with the number of checks that failed.
+#include "raylib.h"
+#include "FastMath.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Samples per sweep, spread evenly over each function's domain
+#define SWEEP_SAMPLES (1 << 22)
+
+// Array lengths that aren't a multiple of four so the scalar tails run too
+#define SWEEP_BATCH 1023
+
+#if defined(MATH_SSE)
+#define INV_SQRT_BOUND 3e-7
+#else
+#define INV_SQRT_BOUND 5e-6
+#endif
+
+static int failures = 0;
+
+static void Check(const char* name, double error, double bound)
+{
+    const bool pass = error <= bound;
+    printf("%-28s %.3g (bound %.3g) %s\n", name, error, bound, pass ? "ok" : "FAILED");
+    if (!pass) failures++;
+}
+
+static void Check(const char* name, bool pass)
+{
+    printf("%-28s %s\n", name, pass ? "ok" : "FAILED");
+    if (!pass) failures++;
+}
+
+static double Max(double a, double b)
+{
+    return a > b ? a : b;
+}
+
+// Scatters sample i over [0, 1) so neighbouring directions get very different lengths
+static double Scatter(int i)
+{
+    return (double)((unsigned)i * 7919u % 1000u) / 1000.0;
+}
+
+static void SweepSinCos()
+{
+    double nearError = 0.0, farError = 0.0, directionError = 0.0, arrayNearError = 0.0, arrayFarError = 0.0;
+    std::vector<float> angles, sines(SWEEP_BATCH), cosines(SWEEP_BATCH);
+    std::vector<Vector2> directions(SWEEP_BATCH);
+    for (int i = 0; i <= SWEEP_SAMPLES; i++)
+    {
+        const float angle = -32768.0f + 65536.0f * (float)i / SWEEP_SAMPLES;
+        if (fabsf(angle) >= 32768.0f) continue;
+
+        float sine, cosine;
+        SinCosFast(angle, sine, cosine);
+        const double error = Max(fabs(sine - sin((double)angle)), fabs(cosine - cos((double)angle)));
+        if (fabsf(angle) < 8192.0f) nearError = Max(nearError, error);
+        else farError = Max(farError, error);
+
+        const Vector2 direction = DirectionFast(angle);
+        directionError = Max(directionError, Max(fabs(direction.x - cosine), fabs(direction.y - sine)));
+
+        angles.push_back(angle);
+        if ((int)angles.size() < SWEEP_BATCH && i < SWEEP_SAMPLES) continue;
+
+        const size_t count = angles.size();
+        SinCosFast(angles.data(), sines.data(), cosines.data(), count);
+        DirectionFast(angles.data(), directions.data(), count);
+        for (size_t k = 0; k < count; k++)
+        {
+            const double a = angles[k];
+            const double arrayError = Max(Max(fabs(sines[k] - sin(a)), fabs(cosines[k] - cos(a))),
+                Max(fabs(directions[k].y - sin(a)), fabs(directions[k].x - cos(a))));
+            if (fabs(a) < 8192.0) arrayNearError = Max(arrayNearError, arrayError);
+            else arrayFarError = Max(arrayFarError, arrayError);
+        }
+        angles.clear();
+    }
+
+    Check("SinCosFast |angle| < 8192", nearError, 1e-7);
+    Check("SinCosFast |angle| < 32768", farError, 5e-7);
+    Check("DirectionFast vs SinCosFast", directionError, 0.0);
+    Check("SinCosFast[] |angle| < 8192", arrayNearError, 1e-7);
+    Check("SinCosFast[] |angle| < 32768", arrayFarError, 5e-7);
+}
+
+// Every 64th float from FLT_MIN up
+static void SweepInvSqrt()
+{
+    double error = 0.0, arrayError = 0.0;
+    std::vector<float> in, out(SWEEP_BATCH);
+    const uint32_t first = 0x00800000u, last = 0x7f7fffffu;
+    for (uint64_t bits = first; bits <= last; bits += 64)
+    {
+        const uint32_t pattern = (uint32_t)bits;
+        float x;
+        memcpy(&x, &pattern, sizeof(x));
+        const double exact = 1.0 / sqrt((double)x);
+        error = Max(error, fabs(InvSqrtFast(x) / exact - 1.0));
+
+        in.push_back(x);
+        if ((int)in.size() < SWEEP_BATCH && bits + 64 <= last) continue;
+
+        InvSqrtFast(in.data(), out.data(), in.size());
+        for (size_t k = 0; k < in.size(); k++)
+            arrayError = Max(arrayError, fabs(out[k] * sqrt((double)in[k]) - 1.0));
+        in.clear();
+    }
+
+    Check("InvSqrtFast relative", error, INV_SQRT_BOUND);
+    Check("InvSqrtFast[] relative", arrayError, INV_SQRT_BOUND);
+}
+
+// Unit circle directions at lengths from 1e-18 to 1e18, plus zero and vectors too short to normalize
+static void SweepNormalize()
+{
+    double error = 0.0;
+    bool zeros = true;
+    std::vector<Vector2> in, out(SWEEP_BATCH);
+    for (int i = 0; i <= SWEEP_SAMPLES; i++)
+    {
+        const double angle = 2.0 * PI * i / SWEEP_SAMPLES;
+        const double length = pow(10.0, -18.0 + 36.0 * Scatter(i));
+        in.push_back({ (float)(cos(angle) * length), (float)(sin(angle) * length) });
+        if ((int)in.size() < SWEEP_BATCH - 2 && i < SWEEP_SAMPLES) continue;
+
+        in.push_back({ 0.0f, 0.0f });
+        in.push_back({ 1e-30f, -1e-30f });
+        NormalizeFast(in.data(), out.data(), in.size());
+        for (size_t k = 0; k + 2 < in.size(); k++)
+        {
+            const double x = in[k].x, y = in[k].y;
+            const double exact = sqrt(x * x + y * y);
+            error = Max(error, Max(fabs(out[k].x - x / exact), fabs(out[k].y - y / exact)));
+        }
+        for (size_t k = in.size() - 2; k < in.size(); k++)
+            zeros = zeros && out[k].x == 0.0f && out[k].y == 0.0f;
+        in.clear();
+    }
+
+    Check("NormalizeFast[]", error, INV_SQRT_BOUND);
+    Check("NormalizeFast[] short is zero", zeros);
+}
+
+// Points around the circle at lengths from 1e-6 to 1e6, plus the axes and signed zeros
+static void SweepAtan2()
+{
+    double error = 0.0, arrayError = 0.0, angleError = 0.0;
+    std::vector<float> ys, xs, out(SWEEP_BATCH);
+    std::vector<Vector2> points;
+    std::vector<float> angles(SWEEP_BATCH);
+    const Vector2 origin = { 3.0f, -2.0f };
+    for (int i = 0; i <= SWEEP_SAMPLES; i++)
+    {
+        const double angle = -PI + 2.0 * PI * i / SWEEP_SAMPLES;
+        const double length = pow(10.0, -6.0 + 12.0 * Scatter(i));
+        const float x = (float)(cos(angle) * length);
+        const float y = (float)(sin(angle) * length);
+        error = Max(error, fabs(Atan2Fast(y, x) - atan2((double)y, (double)x)));
+
+        ys.push_back(y);
+        xs.push_back(x);
+        const float unitX = (float)cos(angle), unitY = (float)sin(angle);
+        points.push_back({ origin.x + unitX, origin.y + unitY });
+        if ((int)ys.size() < SWEEP_BATCH && i < SWEEP_SAMPLES) continue;
+
+        Atan2Fast(ys.data(), xs.data(), out.data(), ys.size());
+        AngleFast(origin, points.data(), angles.data(), points.size());
+        for (size_t k = 0; k < ys.size(); k++)
+        {
+            arrayError = Max(arrayError, fabs(out[k] - atan2((double)ys[k], (double)xs[k])));
+            const double dx = points[k].x - origin.x, dy = points[k].y - origin.y;
+            angleError = Max(angleError, fabs(angles[k] - atan2((double)(float)dy, (double)(float)dx)));
+        }
+        ys.clear();
+        xs.clear();
+        points.clear();
+    }
+
+    // Axes and signed zeros land exactly where atan2f puts them
+    const float special[][2] = { { 0.0f, 0.0f }, { -0.0f, 0.0f }, { 0.0f, -0.0f }, { -0.0f, -0.0f },
+        { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f }, { -0.0f, -1.0f } };
+    bool axes = true;
+    for (const auto& point : special)
+    {
+        const float fast = Atan2Fast(point[0], point[1]);
+        const float exact = atan2f(point[0], point[1]);
+        axes = axes && fabsf(fast - exact) <= 6e-7f && std::signbit(fast) == std::signbit(exact);
+    }
+
+    Check("Atan2Fast", error, 6e-7);
+    Check("Atan2Fast[]", arrayError, 6e-7);
+    Check("AngleFast[]", angleError, 6e-7);
+    Check("Atan2Fast axes and zeros", axes);
+}
+
+int main()
+{
+    SweepSinCos();
+    SweepInvSqrt();
+    SweepNormalize();
+    SweepAtan2();
+    printf("%d failed\n", failures);
+    return failures;
+}
@@ -12,6 +12,19 @@ newoption
 	default = "opengl33"
 }
 
+newoption
+{
+	trigger = "scalar",
+	value = "TYPE",
+	description = "number type of the Scalar lockstep code (ScalarRigidbody, Scalar collision), fixed point replays bit for bit everywhere. PhysicsWorld and the demo stay on float",
+	allowed = {
+		{ "float", "32 bit float"},
+		{ "q16", "Q16.16 fixed point"},
+		{ "q32", "Q32.32 fixed point"}
+	},
+	default = "float"
+}
+
 function define_C()
 	language "C"
 end
@@ -86,7 +99,7 @@ workspace "sunshine"
 	
 
 	cdialect "C99"
-	cppdialect "C++11"
+	cppdialect "C++17"
 	check_raylib()
 	check_imgui()
 
@@ -160,3 +173,21 @@ project "game"
 	link_raylib()
 	links {"rlImGui"}
 	includedirs {"./", "imgui", "imgui-master" }
+
+	filter {"options:scalar=q16"}
+		defines {"FIXED_POINT_BITS=16"}
+
+	filter {"options:scalar=q32"}
+		defines {"FIXED_POINT_BITS=32"}
+
+	filter {}
+
+project "fastmath_test"
+	kind "ConsoleApp"
+	language "C++"
+	location "_build"
+	targetdir "_bin/%{cfg.buildcfg}"
+
+	files {"game/test/FastMathTest.cpp"}
+	include_raylib()
+	includedirs {"game/src"}